@@ -336,6 +336,7 @@ namespace SFG
 #else
 					_game->post_world_tick(dt_seconds);
 #endif
+					_world->flush_entity_commands();
 					ticks++;
 				}
 
@@ -364,6 +365,7 @@ namespace SFG
 #else
 				_game->post_world_tick(dtt);
 #endif
+				_world->flush_entity_commands();
 				_world->calculate_abs_transforms();
 				_render_stream.publish();
 			}
@@ -0,0 +1,274 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cook_cache.hpp"
+
+#ifdef SFG_TOOLMODE
+
+#include "serialization/serialization.hpp"
+#include "data/ostream_vector.hpp"
+#include "data/istream_vector.hpp"
+#include "io/file_system.hpp"
+#include "io/log.hpp"
+
+namespace SFG
+{
+	namespace
+	{
+		constexpr const char* COOK_INDEX_NAME = "cook_index.stkcookidx";
+		constexpr const char* COOK_BLOB_EXT	  = ".stkcook";
+	}
+
+	void cook_cache::load(const char* cache_dir)
+	{
+		_records.clear();
+		_stamps.clear();
+		_dirty = false;
+		_dir   = cache_dir == nullptr ? "" : cache_dir;
+
+		if (_dir.empty())
+			return;
+
+		const string index_path = _dir + COOK_INDEX_NAME;
+		if (!file_system::exists(index_path.c_str()))
+			return;
+
+		istream stream = serialization::load_from_file(index_path.c_str());
+		if (stream.get_size() == 0)
+			return;
+
+		uint32 version = 0;
+		stream >> version;
+
+		// layout changes drop the whole index, blobs left behind are overwritten by key.
+		if (version != COOK_INDEX_VERSION)
+		{
+			stream.destroy();
+			return;
+		}
+
+		uint32 stamp_count = 0;
+		stream >> stamp_count;
+		_stamps.reserve(stamp_count);
+
+		for (uint32 i = 0; i < stamp_count; i++)
+		{
+			file_stamp stamp = {};
+			stream >> stamp.path;
+			stream >> stamp.last_modified;
+			stream >> stamp.hash;
+			_stamps[TO_SID(stamp.path)] = stamp;
+		}
+
+		uint32 record_count = 0;
+		stream >> record_count;
+		_records.reserve(record_count);
+
+		for (uint32 i = 0; i < record_count; i++)
+		{
+			record rec = {};
+			stream >> rec.path;
+			stream >> rec.key;
+			stream >> rec.size;
+			stream >> rec.dependencies;
+			stream >> rec.sub_resources;
+			_records[TO_SID(rec.path)] = std::move(rec);
+		}
+
+		stream.destroy();
+	}
+
+	void cook_cache::save()
+	{
+		if (_dir.empty() || !_dirty)
+			return;
+
+		ostream stream;
+		stream << static_cast<uint32>(COOK_INDEX_VERSION);
+
+		stream << static_cast<uint32>(_stamps.size());
+		for (const auto& [sid, stamp] : _stamps)
+		{
+			stream << stamp.path;
+			stream << stamp.last_modified;
+			stream << stamp.hash;
+		}
+
+		stream << static_cast<uint32>(_records.size());
+		for (const auto& [sid, rec] : _records)
+		{
+			stream << rec.path;
+			stream << rec.key;
+			stream << rec.size;
+			stream << rec.dependencies;
+			stream << rec.sub_resources;
+		}
+
+		const string index_path = _dir + COOK_INDEX_NAME;
+		serialization::save_to_file(index_path.c_str(), stream);
+		stream.destroy();
+		_dirty = false;
+	}
+
+	bool cook_cache::fetch(const string& path, const char* base_dir, ostream& out, vector<string>& out_sub_resources)
+	{
+		if (_dir.empty())
+			return false;
+
+		// copied out, stores from other workers may rehash the map while the key is being calculated.
+		record rec = {};
+		{
+			LOCK_GUARD(_mtx);
+			auto it = _records.find(TO_SID(path));
+			if (it == _records.end())
+				return false;
+			rec = it->second;
+		}
+
+		uint64 key = 0;
+		if (!calculate_key(path, base_dir, rec.dependencies, key) || key != rec.key)
+			return false;
+
+		const string blob_path = get_blob_path(key);
+		if (!file_system::exists(blob_path.c_str()))
+			return false;
+
+		istream stream = serialization::load_from_file(blob_path.c_str());
+		if (stream.get_size() != rec.size)
+		{
+			SFG_WARN("cook cache entry size mismatch, recooking: {0}", path.c_str());
+			stream.destroy();
+			return false;
+		}
+
+		out.write_raw(stream.get_raw(), stream.get_size());
+		stream.destroy();
+
+		out_sub_resources.insert(out_sub_resources.end(), rec.sub_resources.begin(), rec.sub_resources.end());
+		return true;
+	}
+
+	void cook_cache::store(const string& path, const char* base_dir, ostream& cooked, const vector<string>& dependencies, const vector<string>& sub_resources)
+	{
+		if (_dir.empty())
+			return;
+
+		uint64 key = 0;
+		if (!calculate_key(path, base_dir, dependencies, key))
+			return;
+
+		const string blob_path = get_blob_path(key);
+		if (!serialization::save_to_file(blob_path.c_str(), cooked))
+			return;
+
+		LOCK_GUARD(_mtx);
+		record& rec = _records[TO_SID(path)];
+
+		// the key covers the resource path, a replaced blob is never shared with another record.
+		if (rec.key != 0 && rec.key != key)
+		{
+			const string old_blob = get_blob_path(rec.key);
+			if (file_system::exists(old_blob.c_str()))
+				file_system::delete_file(old_blob.c_str());
+		}
+
+		rec.path		  = path;
+		rec.key			  = key;
+		rec.size		  = cooked.get_size();
+		rec.dependencies  = dependencies;
+		rec.sub_resources = sub_resources;
+		_dirty			  = true;
+	}
+
+	bool cook_cache::hash_file(const string& full_path, uint64& out_hash)
+	{
+		if (!file_system::exists(full_path.c_str()))
+			return false;
+
+		const string_id sid			  = TO_SID(full_path);
+		const uint64	last_modified = file_system::get_last_modified_ticks(full_path.c_str());
+
+		// unchanged timestamps reuse the stored hash, touched files are rehashed and still hit if their bytes are the same.
+		{
+			LOCK_GUARD(_mtx);
+			auto it = _stamps.find(sid);
+			if (it != _stamps.end() && it->second.last_modified == last_modified)
+			{
+				out_hash = it->second.hash;
+				return true;
+			}
+		}
+
+		char*  data = nullptr;
+		size_t size = 0;
+		file_system::read_file(full_path.c_str(), data, size);
+		out_hash = hash_bytes(data, data == nullptr ? 0 : size);
+		delete[] data;
+
+		LOCK_GUARD(_mtx);
+		file_stamp& stamp	= _stamps[sid];
+		stamp.path			= full_path;
+		stamp.last_modified = last_modified;
+		stamp.hash			= out_hash;
+		_dirty				= true;
+		return true;
+	}
+
+	bool cook_cache::calculate_key(const string& path, const char* base_dir, const vector<string>& dependencies, uint64& out_key)
+	{
+		const string base = base_dir == nullptr ? "" : base_dir;
+
+		vector<uint64> parts;
+		parts.reserve(3 + dependencies.size() * 2);
+		parts.push_back(COOK_VERSION);
+		parts.push_back(TO_SID(path));
+
+		uint64 file_hash = 0;
+		if (!hash_file(base + path, file_hash))
+			return false;
+		parts.push_back(file_hash);
+
+		for (const string& dep : dependencies)
+		{
+			uint64 dep_hash = 0;
+			if (!hash_file(base + dep, dep_hash))
+				return false;
+
+			parts.push_back(TO_SID(dep));
+			parts.push_back(dep_hash);
+		}
+
+		out_key = hash_bytes(reinterpret_cast<const char*>(parts.data()), parts.size() * sizeof(uint64));
+		return true;
+	}
+
+	string cook_cache::get_blob_path(uint64 key) const
+	{
+		return _dir + std::to_string(key) + COOK_BLOB_EXT;
+	}
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#ifdef SFG_TOOLMODE
+
+#include "common/string_id.hpp"
+#include "data/vector.hpp"
+#include "data/string.hpp"
+#include "data/hash_map.hpp"
+#include "data/mutex.hpp"
+
+// bump whenever any raw serialize() layout or cooking step changes, invalidates every cooked entry.
+#define COOK_VERSION	   3
+#define COOK_INDEX_VERSION 1
+
+namespace SFG
+{
+	class ostream;
+	class istream;
+
+	/*
+	 * Content addressed cache of cooked package entries. Keys hash the resource file, the bytes of every
+	 * source it depends on and COOK_VERSION, cooked bytes are kept in the cache directory under their key.
+	 * Dependencies are recorded per resource from the previous cook, so validating an entry never imports it.
+	 * fetch() and store() may run from cooking workers concurrently, load() and save() may not.
+	 */
+	class cook_cache
+	{
+	private:
+		struct file_stamp
+		{
+			string path			 = "";
+			uint64 last_modified = 0;
+			uint64 hash			 = 0;
+		};
+
+		struct record
+		{
+			string		   path = "";
+			uint64		   key	= 0;
+			uint64		   size = 0;
+			vector<string> dependencies;
+			vector<string> sub_resources;
+		};
+
+	public:
+		void load(const char* cache_dir);
+		void save();
+
+		/*
+		 * Appends the cooked bytes of path to out if the recorded key still matches, along with its recorded sub resources.
+		 */
+		bool fetch(const string& path, const char* base_dir, ostream& out, vector<string>& out_sub_resources);
+
+		/*
+		 * Records freshly cooked bytes, dependencies are relative to base_dir just like the resource itself.
+		 */
+		void store(const string& path, const char* base_dir, ostream& cooked, const vector<string>& dependencies, const vector<string>& sub_resources);
+
+	private:
+		bool   hash_file(const string& full_path, uint64& out_hash);
+		bool   calculate_key(const string& path, const char* base_dir, const vector<string>& dependencies, uint64& out_key);
+		string get_blob_path(uint64 key) const;
+
+	private:
+		string							_dir = "";
+		hash_map<string_id, record>		_records;
+		hash_map<string_id, file_stamp> _stamps;
+		mutex							_mtx;
+		bool							_dirty = false;
+	};
+}
+
+#endif
@@ -26,11 +26,23 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "package.hpp"
 #include "serialization/serialization.hpp"
+#include "serialization/compressor.hpp"
 #include "data/ostream.hpp"
+#include "data/hash_map.hpp"
 #include "io/log.hpp"
+#include <algorithm>
+#include <execution>
 
 namespace SFG
 {
+	namespace
+	{
+		inline uint64 align_up(uint64 value, uint64 alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
 	package::~package()
 	{
 		close();
@@ -38,22 +50,53 @@ namespace SFG
 			_write_data.destroy();
 	}
 
-	void package::open(const char* package_file)
+	bool package::open(const char* package_file)
 	{
 		close();
-		_read_data = serialization::load_from_file(package_file);
+
+		// entries are read in place from the mapping, pages only fault in for entries that are actually read.
+		if (_mapped.open(package_file))
+			_read_data = istream(_mapped.get_data(), _mapped.get_size());
+		else
+			_read_data = serialization::load_from_file(package_file);
+
+		if (_read_data.get_size() == 0)
+			return false;
+
 		_header.deserialize(_read_data);
-		_read_header_size = _read_data.tellg();
 		_read_data.seek(0);
+
+		if (_header.magic != PACKAGE_MAGIC || _header.version != PACKAGE_VERSION)
+		{
+			SFG_ERR("package version mismatch, re-package the project: {0}", package_file);
+			close();
+			return false;
+		}
+
+		_entry_buffers.resize(_header.entries.size(), nullptr);
+		return true;
 	}
 
 	void package::close()
 	{
+		for (uint8* buffer : _entry_buffers)
+			delete[] buffer;
+		_entry_buffers.resize(0);
+
 		if (_read_data.get_size() == 0)
 			return;
 
 		_header = {};
-		_read_data.destroy();
+
+		if (_mapped.is_open())
+		{
+			_read_data = {};
+			_mapped.close();
+		}
+		else
+		{
+			_read_data.destroy();
+		}
 	}
 
 	void package::start_writing()
@@ -66,9 +109,13 @@ namespace SFG
 
 	void package::write_resource(string_id id)
 	{
-		_header.resource_table[id] = {
-			.offset = static_cast<uint32>(_write_data.get_size()),
-		};
+		_header.entries.push_back({
+			.sid	= id,
+			.offset = static_cast<uint64>(_write_data.get_size()),
+		});
+
+		// entries are relocated to aligned offsets on close, relative alignment starts at the entry.
+		_write_data.set_origin(_write_data.get_size());
 	}
 
 	void package::write_resource(const char* path)
@@ -81,13 +128,171 @@ namespace SFG
 	{
 		SFG_INFO("saving package to: {0}", output_path);
 
+		vector<package_entry>& entries = _header.entries;
+		const uint8*		   src	   = _write_data.get_raw();
+
+		// entries are written back to back, each one ends where the next one begins.
+		const size_t written = entries.size();
+		for (size_t i = 0; i < written; i++)
+		{
+			const uint64 end			 = i + 1 < written ? entries[i + 1].offset : static_cast<uint64>(_write_data.get_size());
+			entries[i].uncompressed_size = static_cast<uint32>(end - entries[i].offset);
+			entries[i].hash				 = hash_bytes(reinterpret_cast<const char*>(src + entries[i].offset), entries[i].uncompressed_size);
+		}
+
+		// sorted toc, the last write of a repeated id wins.
+		std::stable_sort(entries.begin(), entries.end(), [](const package_entry& a, const package_entry& b) -> bool { return a.sid < b.sid; });
+		size_t unique = 0;
+		for (size_t i = 0; i < written; i++)
+		{
+			if (i + 1 < written && entries[i + 1].sid == entries[i].sid)
+				continue;
+			entries[unique++] = entries[i];
+		}
+		entries.resize(unique);
+
+		const size_t count = entries.size();
+
+		// identical payloads are stored once, duplicates alias the first entry's blob and skip compression and layout.
+		hash_map<uint64, uint32> blob_by_hash;
+		vector<int32>			 alias_of(count, -1);
+		uint64					 aliased_bytes = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			package_entry& e  = entries[i];
+			auto		   it = blob_by_hash.find(e.hash);
+			if (it == blob_by_hash.end())
+			{
+				blob_by_hash[e.hash] = static_cast<uint32>(i);
+				continue;
+			}
+
+			const package_entry& c = entries[it->second];
+			if (c.uncompressed_size != e.uncompressed_size || memcmp(src + c.offset, src + e.offset, e.uncompressed_size) != 0)
+				continue;
+
+			alias_of[i] = static_cast<int32>(it->second);
+			e.alias		= c.sid;
+			aliased_bytes += e.uncompressed_size;
+		}
+
+		if (aliased_bytes != 0)
+			SFG_INFO("package aliased {0} bytes of duplicate entries", aliased_bytes);
+
+		// small entries (materials, samplers, templates) barely compress alone, they share a dictionary built from the small entries themselves.
+		_header.dictionary.resize(0);
+		vector<span<const uint8>> samples;
+		for (size_t i = 0; i < count; i++)
+		{
+			const package_entry& e = entries[i];
+			if (alias_of[i] == -1 && e.uncompressed_size >= PACKAGE_DICT_MIN_ENTRY && e.uncompressed_size < PACKAGE_COMPRESS_MIN)
+				samples.push_back({.data = src + e.offset, .size = e.uncompressed_size});
+		}
+
+		if (samples.size() >= PACKAGE_DICT_MIN_SAMPLES)
+			compressor::build_dictionary(samples, _header.dictionary);
+
+		const vector<uint8>* dictionary = _header.dictionary.empty() ? nullptr : &_header.dictionary;
+
+		// compress each entry on its own, only kept when it actually saves space.
+		// entries are independent once the dictionary is built, each one writes only its own slot.
+		// packages are what ships, so they pay for the high level once at cook time, decode speed is the same.
+		const compressor_level level = compressor_level::high;
+
+		vector<const uint8*>  payloads(count, nullptr);
+		vector<vector<uint8>> compressed(count);
+		vector<uint32>		  blob_indices;
+		blob_indices.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			if (alias_of[i] == -1)
+				blob_indices.push_back(static_cast<uint32>(i));
+		}
+
+		std::for_each(std::execution::par, blob_indices.begin(), blob_indices.end(), [&](uint32 i) {
+			package_entry& e = entries[i];
+			const uint8*   p = src + e.offset;
+			payloads[i]		 = p;
+			e.size			 = e.uncompressed_size;
+			e.codec			 = package_codec::none;
+
+			package_codec codec = package_codec::lz4;
+
+			if (e.uncompressed_size < PACKAGE_COMPRESS_MIN)
+			{
+				if (dictionary == nullptr || e.uncompressed_size < PACKAGE_DICT_MIN_ENTRY)
+					return;
+
+				codec = package_codec::lz4_dict;
+				if (!compressor::compress_block(p, e.uncompressed_size, compressed[i], dictionary, level))
+					return;
+			}
+			else if (e.uncompressed_size >= PACKAGE_LARGE_ENTRY)
+			{
+				// framed, bounded scratch per block and no int limits on the entry size.
+				codec = package_codec::lz4_frame;
+				ostream frame;
+				frame.create(e.uncompressed_size / 2 + 64);
+				compressor::compress_frame(p, e.uncompressed_size, frame, level);
+				compressed[i].assign(frame.get_raw(), frame.get_raw() + frame.get_size());
+				frame.destroy();
+			}
+			else if (!compressor::compress_block(p, e.uncompressed_size, compressed[i], nullptr, level))
+				return;
+
+			if (compressed[i].size() >= e.uncompressed_size - e.uncompressed_size / 8)
+				return;
+
+			payloads[i] = compressed[i].data();
+			e.size		= static_cast<uint32>(compressed[i].size());
+			e.codec		= codec;
+		});
+
+		// toc is fixed size per entry, measure it once to lay out aligned offsets.
+		ostream toc;
+		_header.serialize(toc);
+		uint64 cursor = static_cast<uint64>(toc.get_size());
+		toc.destroy();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			package_entry& e = entries[i];
+
+			// a blob always comes before its aliases in sid order, its layout is final by now.
+			if (alias_of[i] != -1)
+			{
+				const package_entry& c = entries[alias_of[i]];
+				e.offset			   = c.offset;
+				e.size				   = c.size;
+				e.codec				   = c.codec;
+				e.alignment			   = c.alignment;
+				continue;
+			}
+
+			e.alignment = e.uncompressed_size >= PACKAGE_LARGE_ENTRY ? PACKAGE_LARGE_ALIGNMENT : PACKAGE_ALIGNMENT;
+			e.offset	= align_up(cursor, e.alignment);
+			cursor		= e.offset + e.size;
+		}
+
+		static const uint8 padding[PACKAGE_LARGE_ALIGNMENT] = {};
+
 		ostream package_content;
+		package_content.create(static_cast<size_t>(cursor));
 		_header.serialize(package_content);
 
-		package_content.write_raw(_write_data.get_raw(), _write_data.get_size());
+		for (size_t i = 0; i < count; i++)
+		{
+			if (alias_of[i] != -1)
+				continue;
+
+			const package_entry& e = entries[i];
+			package_content.write_raw(padding, static_cast<size_t>(e.offset) - package_content.get_size());
+			package_content.write_raw(payloads[i], e.size);
+		}
+
 		_write_data.destroy();
 
-		serialization::save_to_file(output_path, package_content);
+		serialization::save_to_file(output_path, package_content, false);
 		package_content.destroy();
 	}
 
@@ -96,14 +301,21 @@ namespace SFG
 		return _write_data;
 	}
 
-	const package_entry& package::get_entry(const char* relative)
+	const package_entry* package::get_entry(const char* relative) const
 	{
 		return get_entry(TO_SID(relative));
 	}
 
-	const package_entry& package::get_entry(string_id sid)
+	const package_entry* package::get_entry(string_id sid) const
 	{
-		return _header.resource_table.at(sid);
+		const int32 index = _header.find(sid);
+		return index == -1 ? nullptr : &_header.entries[index];
+	}
+
+	string_id package::get_canonical(string_id sid) const
+	{
+		const package_entry* e = get_entry(sid);
+		return e == nullptr || e->alias == 0 ? sid : e->alias;
 	}
 
 	bool package::get_stream(const char* entry_begin_relative, istream& out)
@@ -114,44 +326,139 @@ namespace SFG
 
 	bool package::get_stream(string_id sid, istream& out)
 	{
-		auto it = _header.resource_table.find(sid);
-		if (it == _header.resource_table.end())
+		const int32 index = _header.find(sid);
+		if (index == -1)
 			return false;
-		const size_t off = _read_header_size + static_cast<size_t>(it->second.offset);
 
-		if (off > _read_data.get_size())
+		const package_entry& e = _header.entries[index];
+		if (e.offset + e.size > _read_data.get_size())
 			return false;
 
-		out = istream(_read_data.get_raw() + off, _read_data.get_size() - off);
+		uint8* stored = _read_data.get_raw() + e.offset;
+
+		if (e.codec == package_codec::none)
+		{
+			out = istream(stored, e.size);
+			return true;
+		}
+
+		// decompressed once into a buffer owned by the package until the entry is released.
+		uint8*& buffer = _entry_buffers[index];
+		if (buffer == nullptr)
+		{
+			buffer = new uint8[e.uncompressed_size];
+
+			bool ok = false;
+			switch (e.codec)
+			{
+			case package_codec::lz4:
+				ok = compressor::decompress_block(stored, e.size, buffer, e.uncompressed_size);
+				break;
+			case package_codec::lz4_dict:
+				ok = compressor::decompress_block(stored, e.size, buffer, e.uncompressed_size, &_header.dictionary);
+				break;
+			case package_codec::lz4_frame:
+				ok = compressor::decompress_frame(stored, e.size, buffer, e.uncompressed_size);
+				break;
+			default:
+				break;
+			}
+
+			if (!ok)
+			{
+				delete[] buffer;
+				buffer = nullptr;
+				return false;
+			}
+
+#ifdef SFG_DEBUG
+			SFG_ASSERT(hash_bytes(reinterpret_cast<const char*>(buffer), e.uncompressed_size) == e.hash);
+#endif
+		}
+
+		out = istream(buffer, e.uncompressed_size);
 		return true;
 	}
 
+	void package::release_entry(string_id sid)
+	{
+		const int32 index = _header.find(sid);
+		if (index == -1)
+			return;
+
+		delete[] _entry_buffers[index];
+		_entry_buffers[index] = nullptr;
+
+		const package_entry& e = _header.entries[index];
+		if (_mapped.is_open())
+			_mapped.release_range(static_cast<size_t>(e.offset), static_cast<size_t>(e.size));
+	}
+
 	void package_header::serialize(ostream& stream) const
 	{
-		const uint32 entry_count = static_cast<uint32>(resource_table.size());
+		const uint32 entry_count = static_cast<uint32>(entries.size());
+		stream << magic;
+		stream << version;
 		stream << entry_count;
 
-		for (const auto& [sid, e] : resource_table)
+		for (const package_entry& e : entries)
 		{
-			stream << sid;
+			stream << e.sid;
+			stream << e.alias;
 			stream << e.offset;
+			stream << e.hash;
+			stream << e.size;
+			stream << e.uncompressed_size;
+			stream << e.alignment;
+			stream << static_cast<uint8>(e.codec);
 		}
+
+		const uint32 dictionary_size = static_cast<uint32>(dictionary.size());
+		stream << dictionary_size;
+		if (dictionary_size != 0)
+			stream.write_raw(dictionary.data(), dictionary.size());
 	}
 
 	void package_header::deserialize(istream& stream)
 	{
-		resource_table.clear();
+		entries.resize(0);
+		dictionary.resize(0);
+
+		stream >> magic;
+		stream >> version;
+		if (magic != PACKAGE_MAGIC || version != PACKAGE_VERSION)
+			return;
 
 		uint32 entry_count = 0;
 		stream >> entry_count;
+		entries.resize(entry_count);
 
-		for (uint32 i = 0; i < entry_count; i++)
+		for (package_entry& e : entries)
 		{
-			package_entry e	  = {};
-			string_id	  sid = 0;
-			stream >> sid;
+			uint8 codec = 0;
+			stream >> e.sid;
+			stream >> e.alias;
 			stream >> e.offset;
-			resource_table[sid] = e;
+			stream >> e.hash;
+			stream >> e.size;
+			stream >> e.uncompressed_size;
+			stream >> e.alignment;
+			stream >> codec;
+			e.codec = static_cast<package_codec>(codec);
 		}
+
+		uint32 dictionary_size = 0;
+		stream >> dictionary_size;
+		dictionary.resize(dictionary_size);
+		if (dictionary_size != 0)
+			stream.read_to_raw(dictionary.data(), dictionary.size());
+	}
+
+	int32 package_header::find(string_id sid) const
+	{
+		auto it = std::lower_bound(entries.begin(), entries.end(), sid, [](const package_entry& e, string_id id) -> bool { return e.sid < id; });
+		if (it == entries.end() || it->sid != sid)
+			return -1;
+		return static_cast<int32>(it - entries.begin());
 	}
 }
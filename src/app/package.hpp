@@ -27,27 +27,60 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "common/string_id.hpp"
 #include "common/size_definitions.hpp"
-#include "data/hash_map.hpp"
+#include "data/vector.hpp"
 #include "data/ostream.hpp"
 #include "data/istream.hpp"
+#include "platform/mapped_file.hpp"
 
 namespace SFG
 {
 	class ostream;
 
+#define PACKAGE_MAGIC			 0x4B504653 // SFPK
+#define PACKAGE_VERSION			 6
+#define PACKAGE_ALIGNMENT		 4096
+#define PACKAGE_LARGE_ALIGNMENT	 65536
+#define PACKAGE_LARGE_ENTRY		 1048576
+#define PACKAGE_COMPRESS_MIN	 4096
+#define PACKAGE_DICT_MIN_ENTRY	 64
+#define PACKAGE_DICT_MIN_SAMPLES 8
+
+	enum class package_codec : uint8
+	{
+		none,
+		lz4,
+		lz4_dict,
+		lz4_frame,
+	};
+
 	struct package_entry
 	{
-		uint32 offset = 0;
-		uint32 size	  = 0;
+		string_id	  sid				= 0;
+		string_id	  alias				= 0;
+		uint64		  offset			= 0;
+		uint64		  hash				= 0;
+		uint32		  size				= 0;
+		uint32		  uncompressed_size = 0;
+		uint32		  alignment			= 0;
+		package_codec codec				= package_codec::none;
 	};
 
+	/*
+	 * Table of contents, sorted by sid. Offsets are absolute within the file, sizes are as stored on disk,
+	 * hash is over the uncompressed bytes.
+	 * Entries below PACKAGE_COMPRESS_MIN share a dictionary built from themselves, entries from PACKAGE_LARGE_ENTRY up are framed.
+	 * Entries with identical bytes are stored once, later ones keep their own slot but alias the sid whose blob they share.
+	 */
 	struct package_header
 	{
-		uint32							   entry_count = 0;
-		hash_map<string_id, package_entry> resource_table;
+		uint32				  magic	  = PACKAGE_MAGIC;
+		uint32				  version = PACKAGE_VERSION;
+		vector<package_entry> entries;
+		vector<uint8>		  dictionary;
 
-		void serialize(ostream& stream) const;
-		void deserialize(istream& stream);
+		void  serialize(ostream& stream) const;
+		void  deserialize(istream& stream);
+		int32 find(string_id sid) const;
 	};
 
 	class package
@@ -55,7 +88,7 @@ namespace SFG
 	public:
 		~package();
 
-		void open(const char* package_file);
+		bool open(const char* package_file);
 		void close();
 
 		void	 start_writing();
@@ -64,15 +97,18 @@ namespace SFG
 		void	 close_writing(const char* output_path);
 		ostream& get_write_stream();
 
-		const package_entry& get_entry(const char* relative);
-		const package_entry& get_entry(string_id sid);
+		const package_entry* get_entry(const char* relative) const;
+		const package_entry* get_entry(string_id sid) const;
+		string_id			 get_canonical(string_id sid) const;
 		bool				 get_stream(const char* entry_begin_relative, istream& out);
 		bool				 get_stream(string_id, istream& out);
+		void				 release_entry(string_id sid);
 
 	private:
-		package_header _header			 = {};
-		size_t		   _read_header_size = 0;
-		istream		   _read_data		 = {};
-		ostream		   _write_data		 = {};
+		package_header _header		  = {};
+		istream		   _read_data	  = {};
+		ostream		   _write_data	  = {};
+		mapped_file	   _mapped		  = {};
+		vector<uint8*> _entry_buffers = {};
 	};
 }
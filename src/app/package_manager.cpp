@@ -26,12 +26,14 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "app/package_manager.hpp"
 #include "io/file_system.hpp"
+#include "io/log.hpp"
+#include "io/assert.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "app/engine_resources.hpp"
+#include "app/cook_cache.hpp"
 #include "editor/editor_settings.hpp"
 #include "io/file_system.hpp"
-#include "io/log.hpp"
 #include "reflection/reflection.hpp"
 #include "resources/world_raw.hpp"
 #include "resources/shader.hpp"
@@ -58,6 +60,9 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "resources/entity_template_raw.hpp"
 #include "data/hash_map.hpp"
 #include "data/string.hpp"
+#include "data/ostream.hpp"
+#include <algorithm>
+#include <execution>
 #endif
 
 namespace SFG
@@ -82,166 +87,278 @@ namespace SFG
 			return true;
 		}
 
-		void append_sub_resources(vector<string>& pending, const vector<string>& subs)
+		void expand_sub_resources(vector<string>& paths, const hash_map<string_id, vector<string>>& sub_resources)
 		{
-			for (const string& res : subs)
+			hash_map<string_id, uint8> seen;
+			for (const string& p : paths)
+				seen[TO_SID(p)] = 1;
+
+			for (size_t i = 0; i < paths.size(); i++)
 			{
-				if (!res.empty())
-					pending.push_back(res);
+				auto it = sub_resources.find(TO_SID(paths[i]));
+				if (it == sub_resources.end())
+					continue;
+
+				for (const string& sub : it->second)
+				{
+					const string_id sid = TO_SID(sub);
+					if (seen.find(sid) != seen.end())
+						continue;
+
+					seen[sid] = 1;
+					paths.push_back(sub);
+				}
 			}
 		}
 
-		void package_resources(const vector<string>& relative_paths, package& pkg, const char* base_dir, const char* cache_dir)
+		/*
+		 * Packaged resources are keyed by path in the table and the import source is tool only. Dropping both from
+		 * heavy leaf payloads makes duplicate imports byte identical, so the package stores them once as aliases.
+		 */
+		template <typename T> void strip_identity(T& raw)
+		{
+			raw.name.clear();
+			raw.source.clear();
+		}
+
+		// only model-embedded textures are registered by sid, packaged ones go by their path.
+		void strip_identity(texture_raw& raw)
 		{
-			vector<string>			   pending = relative_paths;
-			hash_map<string_id, uint8> packed;
+			raw.name.clear();
+			raw.source.clear();
+			raw.sid = 0;
+		}
 
+		bool cook_resource(string_id type, const string& path, const char* base_dir, const char* cache_dir, ostream& out, vector<string>& out_sub_resources, vector<string>& out_dependencies)
+		{
+			if (type == type_id<shader>::value)
+			{
+				shader_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				raw.destroy();
+			}
+			else if (type == type_id<material>::value)
+			{
+				material_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				raw.destroy();
+			}
+			else if (type == type_id<texture>::value)
+			{
+				texture_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				strip_identity(raw);
+				raw.serialize(out);
+			}
+			else if (type == type_id<texture_sampler>::value)
+			{
+				texture_sampler_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+			}
+			else if (type == type_id<audio>::value)
+			{
+				audio_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				strip_identity(raw);
+				raw.serialize(out);
+			}
+			else if (type == type_id<font>::value)
+			{
+				font_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				strip_identity(raw);
+				raw.serialize(out);
+			}
+			else if (type == type_id<model>::value)
+			{
+				model_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+
+				for (material_raw& m : raw.loaded_materials)
+					m.destroy();
+			}
+			else if (type == type_id<physical_material>::value)
+			{
+				physical_material_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+			}
+			else if (type == type_id<particle_properties>::value)
+			{
+				particle_properties_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+			}
+			else if (type == type_id<res_state_machine>::value)
+			{
+				res_state_machine_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+			}
+			else if (type == type_id<entity_template>::value)
+			{
+				entity_template_raw raw = {};
+				if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					return false;
+				raw.serialize(out);
+				raw.get_sub_resources(out_sub_resources);
+				raw.get_dependencies(out_dependencies);
+				raw.destroy();
+			}
+			else
+			{
+				SFG_ERR("unknown resource type: {0}", path.c_str());
+				return false;
+			}
+
+			return true;
+		}
+
+		struct cook_job
+		{
+			string		   path	  = "";
+			string_id	   type	  = 0;
+			ostream		   cooked = {};
 			vector<string> sub_resources;
-			sub_resources.reserve(16);
+			vector<string> dependencies;
+			bool		   ok = false;
+		};
 
-			size_t index = 0;
-			while (index < pending.size())
+		void run_cook_job(cook_job& job, const char* base_dir, const char* cache_dir, cook_cache& cache)
+		{
+			// unchanged resources are copied byte for byte from the cook cache without importing them.
+			if (cache.fetch(job.path, base_dir, job.cooked, job.sub_resources))
 			{
-				const string path = pending[index++];
-				if (path.empty())
-					continue;
+				job.ok = true;
+				return;
+			}
 
-				const string_id sid = TO_SID(path);
-				if (packed.find(sid) != packed.end())
-					continue;
+			if (!cook_resource(job.type, job.path, base_dir, cache_dir, job.cooked, job.sub_resources, job.dependencies))
+				return;
 
-				packed[sid] = 1;
+			cache.store(job.path, base_dir, job.cooked, job.dependencies, job.sub_resources);
+			job.ok = true;
+		}
 
-				const string ext = file_system::get_file_extension(path);
-				if (ext.empty())
-				{
-					SFG_ERR("could not deduce extension: {0}", path.c_str());
-					continue;
-				}
+		void package_resources(const vector<string>& relative_paths, package& pkg, const char* base_dir, const char* cache_dir, cook_cache& cache, hash_map<string_id, vector<string>>* out_sub_resources = nullptr)
+		{
+			vector<cook_job>		   jobs;
+			hash_map<string_id, uint8> seen;
 
-				const meta* m = reflection::get().find_by_tag(ext.c_str());
-				if (m == nullptr)
-				{
-					SFG_ERR("no metadata found associated with this tag: {0}", ext.c_str());
-					continue;
-				}
+			auto add_path = [&](const string& p) {
+				if (p.empty())
+					return;
 
-				const string_id type = m->get_type_id();
+				const string_id sid = TO_SID(p);
+				if (seen.find(sid) != seen.end())
+					return;
 
-				sub_resources.resize(0);
+				seen[sid] = 1;
+				jobs.emplace_back();
+				jobs.back().path = p;
+			};
 
-				if (type == type_id<shader>::value)
-				{
-					shader_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.destroy();
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<material>::value)
-				{
-					material_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-					raw.destroy();
-				}
-				else if (type == type_id<texture>::value)
-				{
-					texture_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<texture_sampler>::value)
-				{
-					texture_sampler_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<audio>::value)
-				{
-					audio_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<font>::value)
-				{
-					font_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<model>::value)
-				{
-					model_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
+			for (const string& p : relative_paths)
+				add_path(p);
 
-					for (material_raw& m : raw.loaded_materials)
-						m.destroy();
-				}
-				else if (type == type_id<physical_material>::value)
-				{
-					physical_material_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<particle_properties>::value)
-				{
-					particle_properties_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
-						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<res_state_machine>::value)
+			vector<int> parallel_indices;
+			vector<int> serial_indices;
+
+			// cook level by level, sub-resources found in one level form the next. levels are appended in order
+			// as soon as they are done, so the table layout matches a single threaded cook and buffers do not pile up.
+			size_t begin = 0;
+			while (begin < jobs.size())
+			{
+				const size_t end = jobs.size();
+				parallel_indices.resize(0);
+				serial_indices.resize(0);
+
+				for (size_t i = begin; i < end; i++)
 				{
-					res_state_machine_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					cook_job&	 job = jobs[i];
+					const string ext = file_system::get_file_extension(job.path);
+					if (ext.empty())
+					{
+						SFG_ERR("could not deduce extension: {0}", job.path.c_str());
 						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-				}
-				else if (type == type_id<entity_template>::value)
-				{
-					entity_template_raw raw = {};
-					if (!load_raw(raw, path.c_str(), base_dir, cache_dir))
+					}
+
+					const meta* m = reflection::get().find_by_tag(ext.c_str());
+					if (m == nullptr)
+					{
+						SFG_ERR("no metadata found associated with this tag: {0}", ext.c_str());
 						continue;
-					pkg.write_resource(path.c_str());
-					raw.serialize(pkg.get_write_stream());
-					raw.get_sub_resources(sub_resources);
-					raw.destroy();
+					}
+
+					job.type = m->get_type_id();
+
+					// shader compilation shares the backend's compiler instances, those stay on this thread.
+					if (job.type == type_id<shader>::value)
+						serial_indices.push_back(static_cast<int>(i));
+					else
+						parallel_indices.push_back(static_cast<int>(i));
 				}
-				else
+
+				std::for_each(std::execution::par, parallel_indices.begin(), parallel_indices.end(), [&](int i) { run_cook_job(jobs[i], base_dir, cache_dir, cache); });
+
+				for (int i : serial_indices)
+					run_cook_job(jobs[i], base_dir, cache_dir, cache);
+
+				for (size_t i = begin; i < end; i++)
 				{
-					SFG_ERR("unknown resource type: {0}", path.c_str());
-					continue;
+					cook_job& job = jobs[i];
+					if (job.ok)
+					{
+						pkg.write_resource(job.path.c_str());
+						pkg.get_write_stream().write_raw(job.cooked.get_raw(), job.cooked.get_size());
+
+						if (out_sub_resources)
+							(*out_sub_resources)[TO_SID(job.path)] = job.sub_resources;
+					}
+
+					job.cooked.destroy();
+
+					// jobs may relocate while sub-resources are appended, copy the list out first.
+					const vector<string> subs = std::move(job.sub_resources);
+					for (const string& sub : subs)
+						add_path(sub);
 				}
 
-				append_sub_resources(pending, sub_resources);
+				begin = end;
 			}
 		}
 	}
@@ -285,7 +402,13 @@ namespace SFG
 
 		world_pkg.start_writing();
 
-		vector<string> resource_paths;
+		vector<string>				resource_paths;
+		vector<string>				world_paths;
+		vector<world_raw>			worlds;
+		vector<entity_template_raw> cell_templates;
+
+		// raws stay in place until their closures are known, reserved up front so live buffers never relocate.
+		worlds.reserve(levels.size());
 
 		for (const string& level : levels)
 		{
@@ -295,33 +418,74 @@ namespace SFG
 			string fixed_path = level;
 			file_system::fix_path(fixed_path);
 
-			world_raw raw = {};
+			worlds.emplace_back();
+			world_raw& raw = worlds.back();
 			if (!raw.load_from_file(fixed_path.c_str(), working_dir.c_str()))
 			{
 				SFG_ERR("failed loading world: {0}", fixed_path.c_str());
+				raw.destroy();
+				worlds.pop_back();
 				continue;
 			}
 
-			world_pkg.write_resource(fixed_path.c_str());
-			raw.serialize(world_pkg.get_write_stream());
+			// partitioned levels keep world-wide entities, everything else moves into per-cell templates.
+			raw.partition_cells(fixed_path, cell_templates);
+			world_paths.push_back(fixed_path);
 
 			for (const string& res : raw.entities_raw.resources)
 			{
 				if (!res.empty())
 					resource_paths.push_back(res);
 			}
+		}
 
-			raw.destroy();
+		for (const entity_template_raw& t : cell_templates)
+		{
+			for (const string& res : t.resources)
+				resource_paths.push_back(res);
 		}
 
-		const string world_path = out_dir + WORLD_PKG_PATH;
-		world_pkg.close_writing(world_path.c_str());
+		hash_map<string_id, vector<string>> sub_resources;
+
+		cook_cache project_cooks = {};
+		project_cooks.load(cache_dir.c_str());
 
 		res_pkg.start_writing();
-		package_resources(resource_paths, res_pkg, working_dir.c_str(), cache_dir.c_str());
+		package_resources(resource_paths, res_pkg, working_dir.c_str(), cache_dir.c_str(), project_cooks, &sub_resources);
+		project_cooks.save();
+
+		// manifests carry the full sub-resource closure, the runtime cell streamer reference counts over it.
+		hash_map<string_id, vector<string>> cell_manifests;
+		for (entity_template_raw& t : cell_templates)
+		{
+			expand_sub_resources(t.resources, sub_resources);
+			cell_manifests[TO_SID(t.name)] = t.resources;
+			res_pkg.write_resource(t.name.c_str());
+			t.serialize(res_pkg.get_write_stream());
+			t.destroy();
+		}
+
 		const string res_path = out_dir + RES_PKG_PATH;
 		res_pkg.close_writing(res_path.c_str());
 
+		for (size_t i = 0; i < worlds.size(); i++)
+		{
+			world_raw& raw = worlds[i];
+			if (!raw.cells.empty())
+				expand_sub_resources(raw.entities_raw.resources, sub_resources);
+
+			// cells reference their manifest before the template is loaded, so it travels with the world too.
+			for (world_cell_raw& c : raw.cells)
+				c.resources = cell_manifests[TO_SID(c.template_path)];
+
+			world_pkg.write_resource(world_paths[i].c_str());
+			raw.serialize(world_pkg.get_write_stream());
+			raw.destroy();
+		}
+
+		const string world_path = out_dir + WORLD_PKG_PATH;
+		world_pkg.close_writing(world_path.c_str());
+
 		vector<string> engine_paths;
 		engine_paths.reserve(64);
 
@@ -332,8 +496,12 @@ namespace SFG
 				engine_paths.push_back(def.path);
 		}
 
+		cook_cache engine_cooks = {};
+		engine_cooks.load(engine_cache_dir.c_str());
+
 		engine_pkg.start_writing();
-		package_resources(engine_paths, engine_pkg, SFG_ROOT_DIRECTORY, engine_cache_dir.c_str());
+		package_resources(engine_paths, engine_pkg, SFG_ROOT_DIRECTORY, engine_cache_dir.c_str(), engine_cooks);
+		engine_cooks.save();
 
 		const string engine_path = out_dir + ENGINE_PKG_PATH;
 		engine_pkg.close_writing(engine_path.c_str());
@@ -343,19 +511,31 @@ namespace SFG
 
 	package& package_manager::open_package_engine_data()
 	{
-		_pk_engine_data.open(ENGINE_PKG_PATH);
+		if (!_pk_engine_data.open(ENGINE_PKG_PATH))
+		{
+			SFG_FATAL("failed opening package: {0}", ENGINE_PKG_PATH);
+			SFG_ASSERT(false);
+		}
 		return _pk_engine_data;
 	}
 
 	package& package_manager::open_package_world()
 	{
-		_pk_world_data.open(WORLD_PKG_PATH);
+		if (!_pk_world_data.open(WORLD_PKG_PATH))
+		{
+			SFG_FATAL("failed opening package: {0}", WORLD_PKG_PATH);
+			SFG_ASSERT(false);
+		}
 		return _pk_world_data;
 	}
 
 	package& package_manager::open_package_res()
 	{
-		_pk_res_data.open(RES_PKG_PATH);
+		if (!_pk_res_data.open(RES_PKG_PATH))
+		{
+			SFG_FATAL("failed opening package: {0}", RES_PKG_PATH);
+			SFG_ASSERT(false);
+		}
 		return _pk_res_data;
 	}
 }
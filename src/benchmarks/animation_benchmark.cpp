@@ -0,0 +1,264 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// Headless animation benchmark: builds a world with N animated characters from the demo assets
+// and ticks the animation graph for M frames without a window or renderer.
+// Only cpu-side data is created, node entities, animations and the state machine, so no gfx backend is needed.
+// usage: StakeforgeAnimationBenchmark [instances=1024] [frames=600] [working_dir=demos/demo0/]
+
+#include "benchmarks/benchmark_common.hpp"
+#include "world/world.hpp"
+#include "world/components/comp_camera.hpp"
+#include "world/components/comp_animation_controller.hpp"
+#include "resources/model_raw.hpp"
+#include "resources/animation.hpp"
+#include "resources/res_state_machine.hpp"
+#include "resources/res_state_machine_raw.hpp"
+#include "gfx/event_stream/render_event_stream.hpp"
+#include "gfx/proxy/render_proxy_entity.hpp"
+#include "data/istream.hpp"
+#include "platform/process.hpp"
+#include "platform/time.hpp"
+#include "io/file_system.hpp"
+#include "io/log.hpp"
+#include "math/math.hpp"
+
+#ifdef SFG_TOOLMODE
+#include "editor/editor_settings.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace SFG
+{
+	namespace
+	{
+		constexpr const char* BENCH_MODEL		  = "assets/character/character.stkmodel";
+		constexpr const char* BENCH_STATE_MACHINE = "assets/character/idle_state_machine.stkanim";
+		constexpr float		  BENCH_DT			  = 1.0f / 60.0f;
+
+		// mirrors entity_manager::instantiate_model without meshes and materials, a controller goes on every skinned mesh node.
+		uint32 instantiate_character(world& w, const model_raw& raw, resource_handle machine_handle, const vector3& position)
+		{
+			entity_manager&	   em = w.get_entity_manager();
+			component_manager& cm = w.get_comp_manager();
+
+			static vector<world_handle> reuse_nodes;
+			reuse_nodes.resize(0);
+
+			const world_handle root = em.create_entity(raw.name.c_str());
+			em.set_entity_position(root, position);
+
+			for (const model_node_raw& node : raw.loaded_nodes)
+			{
+				const world_handle e = em.create_entity(node.name.c_str());
+				reuse_nodes.push_back(e);
+
+				vector3 pos	  = vector3::zero;
+				quat	rot	  = quat::identity;
+				vector3 scale = vector3::zero;
+				node.local_matrix.decompose(pos, rot, scale);
+				em.set_entity_position(e, pos);
+				em.set_entity_rotation(e, rot);
+				em.set_entity_scale(e, scale);
+			}
+
+			const uint32 node_count = static_cast<uint32>(raw.loaded_nodes.size());
+			for (uint32 i = 0; i < node_count; i++)
+			{
+				const int16 parent = raw.loaded_nodes[i].parent_index;
+				em.add_child(parent == -1 ? root : reuse_nodes[parent], reuse_nodes[i]);
+			}
+
+			for (const skin_raw& sk : raw.loaded_skins)
+			{
+				for (const skin_joint& j : sk.joints)
+					em.add_render_proxy(reuse_nodes[j.model_node_index]);
+			}
+
+			uint32 controllers = 0;
+			for (uint32 i = 0; i < node_count; i++)
+			{
+				const model_node_raw& node = raw.loaded_nodes[i];
+				if (node.mesh_index == -1 || node.skin_index == -1)
+					continue;
+
+				const world_handle		   comp_handle = cm.add_component<comp_animation_controller>(reuse_nodes[i]);
+				comp_animation_controller& ac		   = cm.get_component<comp_animation_controller>(comp_handle);
+				ac.set_skin_entities(w, reuse_nodes.data(), static_cast<uint16>(reuse_nodes.size()));
+				ac.set_machine_resource(w, machine_handle);
+				controllers++;
+			}
+
+			return controllers;
+		}
+
+		int run(uint32 instances, uint32 frames, const char* working_dir)
+		{
+#ifndef SFG_TOOLMODE
+			SFG_ERR("animation benchmark imports demo sources and requires a toolmode configuration.");
+			return 1;
+#else
+			editor_settings& settings = editor_settings::get();
+			settings.working_dir	  = working_dir;
+			file_system::fix_path(settings.working_dir);
+			settings.cache_dir = settings.working_dir + "_stakeforge_cache/";
+			if (!file_system::exists(settings.cache_dir.c_str()))
+				file_system::create_directory(settings.cache_dir.c_str());
+
+			render_event_stream stream;
+			stream.init();
+
+			// default resources live on the gpu, everything below only needs the cpu-side world.
+			world* w = new world(stream);
+			w->init_preserve_resources();
+
+			resource_manager&  rm = w->get_resource_manager();
+			entity_manager&	   em = w->get_entity_manager();
+			component_manager& cm = w->get_comp_manager();
+			animation_graph&   ag = w->get_animation_graph();
+
+			model_raw			  model_data   = {};
+			res_state_machine_raw machine_data = {};
+			if (!model_data.load_from_file(BENCH_MODEL, settings.working_dir.c_str()) || !machine_data.load_from_file(BENCH_STATE_MACHINE, settings.working_dir.c_str()))
+			{
+				SFG_ERR("failed loading benchmark assets from {0}", settings.working_dir);
+				w->uninit();
+				delete w;
+				stream.uninit();
+				return 1;
+			}
+
+			// machines resolve their samples by animation hash, so animations go in under the same sids the model would use.
+			for (const animation_raw& anim : model_data.loaded_animations)
+			{
+				const resource_handle h = rm.add_resource<animation>(anim.sid);
+				rm.get_resource<animation>(h).create_from_loader(anim, *w, h);
+			}
+
+			const resource_handle machine_handle = rm.add_resource<res_state_machine>(TO_SID(BENCH_STATE_MACHINE));
+			rm.get_resource<res_state_machine>(machine_handle).create_from_loader(machine_data, *w, machine_handle);
+
+			// forward is -z, turned around to look down +z over the grid of characters. throttling disabled so every machine is posed each frame.
+			const world_handle camera_entity = em.create_entity("camera");
+			const world_handle camera_comp	 = cm.add_component<comp_camera>(camera_entity);
+			comp_camera&	   cam			 = cm.get_component<comp_camera>(camera_comp);
+			em.set_entity_position(camera_entity, vector3(0.0f, 2.0f, -10.0f));
+			em.set_entity_rotation(camera_entity, quat::angle_axis(180.0f, vector3::up));
+			cam.set_values(*w, 0.1f, 1000.0f, 60.0f);
+			cam.set_main(*w);
+			ag.set_throttle_values(MATH_INF_F, 0);
+
+			uint32		 controllers = 0;
+			const uint32 row		 = static_cast<uint32>(math::sqrt(static_cast<float>(instances))) + 1;
+			for (uint32 i = 0; i < instances; i++)
+			{
+				const vector3 position = vector3(static_cast<float>(i % row) * 2.0f - static_cast<float>(row), 0.0f, static_cast<float>(i / row) * 2.0f);
+				controllers += instantiate_character(*w, model_data, machine_handle, position);
+			}
+
+			SFG_INFO("animation benchmark: {0} controllers, {1} frames", controllers, frames);
+
+			stage_samples sample	 = {.name = "sample"};
+			stage_samples blend		 = {.name = "blend"};
+			stage_samples apply		 = {.name = "apply"};
+			stage_samples transforms = {.name = "transforms"};
+			stage_samples total		 = {.name = "total"};
+
+			sample.ms.reserve(frames);
+			blend.ms.reserve(frames);
+			apply.ms.reserve(frames);
+			transforms.ms.reserve(frames);
+			total.ms.reserve(frames);
+
+			// drained every frame in place of the render thread.
+			render_proxy_entity* proxy_entities = new render_proxy_entity[MAX_ENTITIES];
+			uint32				 proxy_count	= 0;
+
+			// culling reads absolute camera and machine transforms, they have to be valid before the first tick.
+			w->calculate_abs_transforms();
+
+			uint32 min_posed = controllers;
+			for (uint32 f = 0; f < frames; f++)
+			{
+				const int64 frame_begin = time::get_cpu_cycles();
+				ag.tick(*w, BENCH_DT);
+				const int64 anim_end = time::get_cpu_cycles();
+				w->calculate_abs_transforms();
+				const int64 frame_end = time::get_cpu_cycles();
+
+				const animation_graph_stats& stats = ag.get_stats();
+				sample.ms.push_back(cycles_to_ms(stats.sample_cycles));
+				blend.ms.push_back(cycles_to_ms(stats.blend_cycles));
+				apply.ms.push_back(cycles_to_ms(stats.apply_cycles));
+				transforms.ms.push_back(cycles_to_ms(frame_end - anim_end));
+				total.ms.push_back(cycles_to_ms(frame_end - frame_begin));
+				min_posed = std::min(min_posed, stats.posed_machines);
+
+				istream events;
+				stream.publish();
+				stream.read(proxy_entities, proxy_count, events);
+			}
+
+			report(sample);
+			report(blend);
+			report(apply);
+			report(transforms);
+			report(total);
+			SFG_INFO("posed machines: min {0} of {1}", min_posed, controllers);
+
+			// a culled machine skips sampling, blending and applying, the timings above would be measuring empty loops.
+			const bool valid = controllers != 0 && min_posed == controllers;
+			if (!valid)
+				SFG_ERR("animation benchmark: {0} of {1} machines posed, camera or throttling culled the rest.", min_posed, controllers);
+
+			delete[] proxy_entities;
+			w->uninit();
+			delete w;
+			stream.uninit();
+			return valid ? 0 : 1;
+#endif
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	SFG::process::init();
+	SFG::time::init();
+
+	const uint32 instances	 = argc > 1 ? static_cast<uint32>(std::atoi(argv[1])) : 1024;
+	const uint32 frames		 = argc > 2 ? static_cast<uint32>(std::atoi(argv[2])) : 600;
+	const char*	 working_dir = argc > 3 ? argv[3] : SFG_ROOT_DIRECTORY "demos/demo0/";
+
+	const int result = SFG::run(std::min(instances, static_cast<uint32>(MAX_WORLD_COMP_ANIMS)), frames, working_dir);
+
+	SFG::time::uninit();
+	SFG::process::uninit();
+	return result;
+}
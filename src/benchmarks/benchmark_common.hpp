@@ -0,0 +1,77 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "data/vector.hpp"
+#include "platform/time.hpp"
+#include "io/log.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace SFG
+{
+	/*
+	 * Timing helpers shared by the headless benchmarks.
+	 * Each stage collects one millisecond sample per frame or round, report sorts them and logs avg and percentiles.
+	 */
+	struct stage_samples
+	{
+		const char*	   name = "";
+		vector<double> ms	= {};
+	};
+
+	inline double percentile(const vector<double>& sorted, double p)
+	{
+		if (sorted.empty())
+			return 0.0;
+
+		const size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+		return sorted[std::min(idx, sorted.size() - 1)];
+	}
+
+	inline void report(stage_samples& stage)
+	{
+		vector<double>& v = stage.ms;
+		std::sort(v.begin(), v.end());
+
+		double sum = 0.0;
+		for (double d : v)
+			sum += d;
+
+		const double avg = v.empty() ? 0.0 : sum / static_cast<double>(v.size());
+
+		char line[256];
+		std::snprintf(line, sizeof(line), "%-12s avg %8.3f ms | p50 %8.3f | p90 %8.3f | p99 %8.3f | max %8.3f", stage.name, avg, percentile(v, 0.5), percentile(v, 0.9), percentile(v, 0.99), v.empty() ? 0.0 : v.back());
+		SFG_INFO("{0}", line);
+	}
+
+	inline double cycles_to_ms(int64 cycles)
+	{
+		return time::get_delta_seconds(0, cycles) * 1000.0;
+	}
+}
@@ -0,0 +1,189 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// Headless resource microbenchmark: adds, looks up and removes N resources by hash through the resource manager
+// and hits sampler deduplication with a small set of descriptors, all without a window or renderer.
+// Resources are only registered in their caches and never created, samplers only emit render events, so no gfx backend is needed.
+// usage: StakeforgeResourceBenchmark [resources=1024] [rounds=200]
+
+#include "benchmarks/benchmark_common.hpp"
+#include "world/world.hpp"
+#include "resources/animation.hpp"
+#include "resources/texture_sampler.hpp"
+#include "gfx/event_stream/render_event_stream.hpp"
+#include "gfx/common/descriptions.hpp"
+#include "platform/process.hpp"
+#include "platform/time.hpp"
+#include "io/log.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace SFG
+{
+	namespace
+	{
+		constexpr uint32 BENCH_SAMPLER_DESCS   = MAX_WORLD_SAMPLERS / 2;
+		constexpr uint32 BENCH_SAMPLER_LOOKUPS = 4096;
+
+		int run(uint32 resources, uint32 rounds)
+		{
+			render_event_stream stream;
+			stream.init();
+
+			// default resources live on the gpu, the caches themselves only need the cpu-side world.
+			world* w = new world(stream);
+			w->init_preserve_resources();
+
+			resource_manager& rm = w->get_resource_manager();
+
+			vector<string_id> hashes;
+			vector<string_id> missing;
+			hashes.reserve(resources);
+			missing.reserve(resources);
+			for (uint32 i = 0; i < resources; i++)
+			{
+				const std::string path = "assets/bench/anim_" + std::to_string(i) + ".stkanim";
+				hashes.push_back(TO_SID(path));
+				missing.push_back(TO_SID(path + ".missing"));
+			}
+
+			// every other handle first so removals land in the middle of the pool, the way level unloads do.
+			vector<uint32> remove_order;
+			remove_order.reserve(resources);
+			for (uint32 i = 0; i < resources; i += 2)
+				remove_order.push_back(i);
+			for (uint32 i = 1; i < resources; i += 2)
+				remove_order.push_back(i);
+
+			sampler_desc descs[BENCH_SAMPLER_DESCS] = {};
+			for (uint32 i = 0; i < BENCH_SAMPLER_DESCS; i++)
+			{
+				descs[i].anisotropy = i;
+				descs[i].lod_bias	= static_cast<float>(i) * 0.25f;
+			}
+
+			SFG_INFO("resource benchmark: {0} resources, {1} sampler descriptors, {2} rounds", resources, BENCH_SAMPLER_DESCS, rounds);
+
+			stage_samples add	   = {.name = "add"};
+			stage_samples lookup   = {.name = "lookup"};
+			stage_samples miss	   = {.name = "miss"};
+			stage_samples hash	   = {.name = "hash"};
+			stage_samples remove   = {.name = "remove"};
+			stage_samples samplers = {.name = "samplers"};
+
+			add.ms.reserve(rounds);
+			lookup.ms.reserve(rounds);
+			miss.ms.reserve(rounds);
+			hash.ms.reserve(rounds);
+			remove.ms.reserve(rounds);
+			samplers.ms.reserve(rounds);
+
+			vector<resource_handle> handles(resources);
+			resource_handle			sampler_handles[BENCH_SAMPLER_DESCS] = {};
+			uint64					checksum							 = 0;
+			bool					valid								 = true;
+
+			for (uint32 r = 0; r < rounds; r++)
+			{
+				const int64 add_begin = time::get_cpu_cycles();
+				for (uint32 i = 0; i < resources; i++)
+					handles[i] = rm.add_resource<animation>(hashes[i]);
+
+				const int64 lookup_begin = time::get_cpu_cycles();
+				for (uint32 i = 0; i < resources; i++)
+					valid &= rm.get_resource_handle_by_hash_if_exists<animation>(hashes[i]) == handles[i];
+
+				const int64 miss_begin = time::get_cpu_cycles();
+				for (uint32 i = 0; i < resources; i++)
+					valid &= rm.get_resource_handle_by_hash_if_exists<animation>(missing[i]).is_null();
+
+				const int64 hash_begin = time::get_cpu_cycles();
+				for (uint32 i = 0; i < resources; i++)
+					checksum += rm.get_resource_hash<animation>(handles[i]);
+
+				const int64 remove_begin = time::get_cpu_cycles();
+				for (uint32 i : remove_order)
+					rm.remove_resource<animation>(handles[i]);
+
+				// the first round creates one sampler per descriptor, every later call has to resolve to the same handles.
+				const int64 samplers_begin = time::get_cpu_cycles();
+				for (uint32 i = 0; i < BENCH_SAMPLER_LOOKUPS; i++)
+				{
+					const uint32		  idx = i % BENCH_SAMPLER_DESCS;
+					const resource_handle h	  = rm.get_or_add_sampler(descs[idx]);
+					if (sampler_handles[idx].is_null())
+						sampler_handles[idx] = h;
+					valid &= h == sampler_handles[idx];
+				}
+				const int64 samplers_end = time::get_cpu_cycles();
+
+				add.ms.push_back(cycles_to_ms(lookup_begin - add_begin));
+				lookup.ms.push_back(cycles_to_ms(miss_begin - lookup_begin));
+				miss.ms.push_back(cycles_to_ms(hash_begin - miss_begin));
+				hash.ms.push_back(cycles_to_ms(remove_begin - hash_begin));
+				remove.ms.push_back(cycles_to_ms(samplers_begin - remove_begin));
+				samplers.ms.push_back(cycles_to_ms(samplers_end - samplers_begin));
+			}
+
+			for (uint32 i = 0; i < resources; i++)
+				valid &= rm.get_resource_handle_by_hash_if_exists<animation>(hashes[i]).is_null();
+
+			if (!valid)
+				SFG_ERR("resource benchmark: lookups resolved to unexpected handles.");
+
+			report(add);
+			report(lookup);
+			report(miss);
+			report(hash);
+			report(remove);
+			report(samplers);
+			SFG_INFO("checksum {0}", checksum);
+
+			w->uninit();
+			delete w;
+			stream.uninit();
+			return valid ? 0 : 1;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	SFG::process::init();
+	SFG::time::init();
+
+	const uint32 resources = argc > 1 ? static_cast<uint32>(std::atoi(argv[1])) : 1024;
+	const uint32 rounds	   = argc > 2 ? static_cast<uint32>(std::atoi(argv[2])) : 200;
+
+	const int result = SFG::run(std::min(resources, static_cast<uint32>(MAX_WORLD_ANIMS)), rounds);
+
+	SFG::time::uninit();
+	SFG::process::uninit();
+	return result;
+}
@@ -32,16 +32,18 @@ namespace SFG
 {
 	void istream::open(uint8* data, size_t size)
 	{
-		_data  = data;
-		_size  = size;
-		_index = 0;
+		_data		= data;
+		_size		= size;
+		_index		= 0;
+		_persistent = false;
 	}
 
 	void istream::close()
 	{
-		_data  = nullptr;
-		_size  = 0;
-		_index = 0;
+		_data		= nullptr;
+		_size		= 0;
+		_index		= 0;
+		_persistent = false;
 	}
 	void istream::create(uint8* data, size_t size)
 	{
@@ -62,9 +64,10 @@ namespace SFG
 			return;
 
 		delete[] _data;
-		_index = 0;
-		_size  = 0;
-		_data  = nullptr;
+		_index		= 0;
+		_size		= 0;
+		_data		= nullptr;
+		_persistent = false;
 	}
 
 	void istream::read_from_ifstream(std::ifstream& stream)
@@ -102,10 +102,22 @@ namespace SFG
 			return _index >= _size;
 		}
 
+		// persistent streams outlive the loaders deserialized from them, loaders may point into the buffer instead of copying.
+		inline void set_persistent(bool persistent)
+		{
+			_persistent = persistent;
+		}
+
+		inline bool is_persistent() const
+		{
+			return _persistent;
+		}
+
 	private:
-		uint8* _data  = nullptr;
-		size_t _index = 0;
-		size_t _size  = 0;
+		uint8* _data	   = nullptr;
+		size_t _index	   = 0;
+		size_t _size	   = 0;
+		bool   _persistent = false;
 	};
 
 	template <typename T> std::enable_if_t<std::is_arithmetic_v<std::remove_reference_t<T>>, istream&> operator>>(istream& stream, T& val)
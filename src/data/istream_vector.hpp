@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "data/vector.hpp"
 #include "data/istream.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -36,6 +37,16 @@ namespace SFG
 		uint32 sz = 0;
 		stream >> sz;
 		v.resize(static_cast<size_t>(sz));
+
+		if constexpr (stream_layout_raw_v<T>)
+		{
+			if (!endianness::should_swap())
+			{
+				stream.read_to_raw(reinterpret_cast<uint8*>(v.data()), v.size() * sizeof(T));
+				return stream;
+			}
+		}
+
 		for (auto& e : v)
 			stream >> e;
 		return stream;
@@ -35,6 +35,7 @@ namespace SFG
 		_data		  = new uint8[size];
 		_total_size	  = size;
 		_current_size = 0;
+		_origin		  = 0;
 	}
 
 	void ostream::destroy()
@@ -43,6 +44,7 @@ namespace SFG
 
 		_current_size = 0;
 		_total_size	  = 0;
+		_origin		  = 0;
 		_data		  = nullptr;
 	}
 
@@ -66,9 +66,22 @@ namespace SFG
 			return _data;
 		}
 
+		// start of the blob currently being written, e.g. a package entry. stream relative alignment is measured from here.
+		inline void set_origin(size_t origin)
+		{
+			_origin = origin;
+		}
+
+		inline size_t get_origin() const
+		{
+			return _origin;
+		}
+
 		inline void shrink(size_t size)
 		{
 			_current_size = size;
+			if (_origin > size)
+				_origin = 0;
 		}
 
 		inline void set(size_t pad, size_t sz, uint8 val)
@@ -84,6 +97,7 @@ namespace SFG
 		uint8* _data		 = nullptr;
 		size_t _current_size = 0;
 		size_t _total_size	 = 0;
+		size_t _origin		 = 0;
 	};
 
 	// arithmetic
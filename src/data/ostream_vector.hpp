@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "data/vector.hpp"
 #include "data/ostream.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -35,6 +36,16 @@ namespace SFG
 	{
 		const uint32 sz = static_cast<uint32>(v.size());
 		stream << sz;
+
+		if constexpr (stream_layout_raw_v<T>)
+		{
+			if (!endianness::should_swap())
+			{
+				stream.write_raw(reinterpret_cast<const uint8*>(v.data()), v.size() * sizeof(T));
+				return stream;
+			}
+		}
+
 		for (auto& e : v)
 			stream << e;
 		return stream;
@@ -0,0 +1,249 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "data/vector.hpp"
+#include "data/istream.hpp"
+#include "data/ostream.hpp"
+#include "serialization/stream_layout.hpp"
+
+namespace SFG
+{
+	/*
+	 * Relocatable array inside a cooked blob. Stored as count, pad, pad bytes and then the elements, aligned to alignof(T) relative to the blob start (ostream origin).
+	 * Deserializing from a persistent stream resolves the array in place: data points into the source buffer and nothing is allocated or copied.
+	 * Non persistent streams, misaligned buffers and big endian hosts copy into owned storage instead.
+	 * In place arrays are only valid while the source buffer is, e.g. until the package entry a loader was decoded from is released.
+	 * Mutating an in place array detaches it into owned storage first.
+	 */
+	template <typename T> class rel_array
+	{
+		static_assert(stream_layout_raw_v<T>, "rel_array elements need a raw stream layout.");
+
+	public:
+		rel_array() = default;
+		rel_array(vector<T>&& v) : _owned(std::move(v)) {};
+
+		rel_array& operator=(vector<T>&& v)
+		{
+			_view		= nullptr;
+			_view_count = 0;
+			_owned		= std::move(v);
+			return *this;
+		}
+
+		// -----------------------------------------------------------------------------
+		// read
+		// -----------------------------------------------------------------------------
+
+		inline size_t size() const
+		{
+			return _view != nullptr ? static_cast<size_t>(_view_count) : _owned.size();
+		}
+
+		inline bool empty() const
+		{
+			return size() == 0;
+		}
+
+		inline bool is_in_place() const
+		{
+			return _view != nullptr;
+		}
+
+		inline const T* data() const
+		{
+			return _view != nullptr ? _view : _owned.data();
+		}
+
+		inline const T* begin() const
+		{
+			return data();
+		}
+
+		inline const T* end() const
+		{
+			return data() + size();
+		}
+
+		inline const T& operator[](size_t i) const
+		{
+			SFG_ASSERT(i < size());
+			return data()[i];
+		}
+
+		inline const T& back() const
+		{
+			SFG_ASSERT(!empty());
+			return data()[size() - 1];
+		}
+
+		// -----------------------------------------------------------------------------
+		// write
+		// -----------------------------------------------------------------------------
+
+		inline T* data()
+		{
+			detach();
+			return _owned.data();
+		}
+
+		inline T* begin()
+		{
+			return data();
+		}
+
+		inline T* end()
+		{
+			return data() + _owned.size();
+		}
+
+		inline T& operator[](size_t i)
+		{
+			detach();
+			SFG_ASSERT(i < _owned.size());
+			return _owned[i];
+		}
+
+		inline T& back()
+		{
+			detach();
+			return _owned.back();
+		}
+
+		inline void push_back(const T& t)
+		{
+			detach();
+			_owned.push_back(t);
+		}
+
+		inline void resize(size_t sz)
+		{
+			detach();
+			_owned.resize(sz);
+		}
+
+		inline void reserve(size_t sz)
+		{
+			detach();
+			_owned.reserve(sz);
+		}
+
+		inline void clear()
+		{
+			_view		= nullptr;
+			_view_count = 0;
+			_owned.clear();
+		}
+
+		// -----------------------------------------------------------------------------
+		// serialization
+		// -----------------------------------------------------------------------------
+
+		void serialize(ostream& stream) const
+		{
+			const uint32 count = static_cast<uint32>(size());
+			stream << count;
+
+			// pad so the elements land aligned relative to the blob start, count and pad byte included. blobs are placed aligned in packages.
+			const size_t elements_at = stream.get_size() - stream.get_origin() + sizeof(uint8);
+			const uint8	 pad		 = static_cast<uint8>((alignof(T) - elements_at % alignof(T)) % alignof(T));
+			stream << pad;
+
+			if (pad != 0)
+			{
+				const uint8 zeros[alignof(T)] = {};
+				stream.write_raw(zeros, pad);
+			}
+
+			if (count == 0)
+				return;
+
+			if (!endianness::should_swap())
+			{
+				stream.write_raw(reinterpret_cast<const uint8*>(data()), static_cast<size_t>(count) * sizeof(T));
+				return;
+			}
+
+			for (const T& e : *this)
+				stream << e;
+		}
+
+		void deserialize(istream& stream)
+		{
+			clear();
+
+			uint32 count = 0;
+			uint8  pad	 = 0;
+			stream >> count;
+			stream >> pad;
+			stream.skip_by(pad);
+
+			if (count == 0)
+				return;
+
+			uint8*		 src	 = stream.get_data_current();
+			const size_t bytes	 = static_cast<size_t>(count) * sizeof(T);
+			const bool	 aligned = reinterpret_cast<size_t>(src) % alignof(T) == 0;
+
+			if (stream.is_persistent() && aligned && !endianness::should_swap())
+			{
+				_view		= reinterpret_cast<const T*>(src);
+				_view_count = count;
+				stream.skip_by(bytes);
+				return;
+			}
+
+			_owned.resize(static_cast<size_t>(count));
+
+			if (!endianness::should_swap())
+			{
+				stream.read_to_raw(reinterpret_cast<uint8*>(_owned.data()), bytes);
+				return;
+			}
+
+			for (T& e : _owned)
+				stream >> e;
+		}
+
+	private:
+		inline void detach()
+		{
+			if (_view == nullptr)
+				return;
+
+			_owned.assign(_view, _view + _view_count);
+			_view		= nullptr;
+			_view_count = 0;
+		}
+
+	private:
+		const T*  _view		  = nullptr;
+		uint32	  _view_count = 0;
+		vector<T> _owned	  = {};
+	};
+}
@@ -39,7 +39,9 @@ namespace SFG
 	static inline constexpr int64  FIXED_FRAMERATE_NS	= static_cast<int64>(FIXED_FRAMERATE_NS_D);
 	static inline constexpr float  FIXED_FRAMERATE_S	= static_cast<float>(FIXED_FRAMERATE_NS_D / 1'000'000'000.0);
 
-#define PHYSICS_RATE_WITHOUT_FIXED_FRAMERATE_NS_D 16'666'667.0
-#define PHYSICS_RATE_WITHOUT_FIXED_FRAMERATE_S	  static_cast<float>(PHYSICS_RATE_WITHOUT_FIXED_FRAMERATE_NS_D / 1'000'000'000.0)
+#define PHYSICS_RATE_HZ		   60.0f
+#define ANIMATION_RATE_HZ	   0.0f // poses are not interpolated, so animation runs at frame rate.
+#define AI_RATE_HZ			   10.0f
+#define AUDIO_LISTENER_RATE_HZ 20.0f
 
 }
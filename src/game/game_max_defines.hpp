@@ -33,7 +33,8 @@ namespace SFG
 	// entities
 	// -----------------------------------------------------------------------------
 
-#define MAX_ENTITIES 256000
+#define MAX_ENTITIES			   256000
+#define MAX_ENTITY_COMMAND_BUFFERS 8
 
 	// -----------------------------------------------------------------------------
 	// resources
@@ -83,6 +84,13 @@ namespace SFG
 #define MAX_WORLD_COMP_SPRITES				 2048
 #define MAX_WORLD_ENEMY_AI_BASIC			 64
 
+	// -----------------------------------------------------------------------------
+	// physics
+	// -----------------------------------------------------------------------------
+
+#define MAX_PHYSICS_CONTACT_EVENTS			 4096
+#define MAX_PHYSICS_CHARACTER_CONTACT_EVENTS 1024
+
 	// -----------------------------------------------------------------------------
 	// animations
 	// -----------------------------------------------------------------------------
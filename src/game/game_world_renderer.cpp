@@ -899,6 +899,8 @@ namespace SFG
 				continue;
 			}
 
+			mi._has_animated_aabb = 0;
+
 			if (mi.skin == NULL_RESOURCE_ID)
 				continue;
 
@@ -921,6 +923,12 @@ namespace SFG
 			}
 			root_global = root_global.inverse();
 
+			// joint spheres are transformed into world space to form the animated bounds used for culling.
+			const float*	bounds_radii   = skin.has_bounds ? aux.get<float>(skin.radii) : nullptr;
+			const matrix4x3 joint_to_world = e.model * root_global;
+			vector3			animated_min   = vector3(MATH_INF_F, MATH_INF_F, MATH_INF_F);
+			vector3			animated_max   = vector3(-MATH_INF_F, -MATH_INF_F, -MATH_INF_F);
+
 			for (uint16 j = 0; j < skin.node_count; j++)
 			{
 				const uint16			   node_index	  = node_indices[j];
@@ -930,8 +938,25 @@ namespace SFG
 
 				bones[assigned_index].mat = (root_global * skin_entity.model * matrices_ptr[j]).to_matrix4x4();
 
+				if (bounds_radii != nullptr)
+				{
+					const matrix4x3 joint_world = joint_to_world * skin_entity.model;
+					const vector3	joint_scale = joint_world.get_scale();
+					const float		radius		= bounds_radii[j] * math::max(joint_scale.x, math::max(joint_scale.y, joint_scale.z));
+					const vector3	center		= joint_world.get_translation();
+					const vector3	extent		= vector3(radius, radius, radius);
+					animated_min				= vector3::min(animated_min, center - extent);
+					animated_max				= vector3::max(animated_max, center + extent);
+				}
+
 				assigned_index++;
 			}
+
+			if (bounds_radii != nullptr && skin.node_count != 0)
+			{
+				mi._animated_aabb	  = aabb(animated_min, animated_max);
+				mi._has_animated_aabb = 1;
+			}
 		}
 
 		if (assigned_index != 0)
@@ -82,7 +82,11 @@ namespace SFG
 		tick_player(dt);
 		tick_doors(dt);
 		tick_managed_entities(dt);
-		tick_enemies(dt);
+
+		const time_manager& tm		 = w.get_time_manager();
+		const uint8			ai_steps = tm.get_subsystem_steps(time_subsystem::ai);
+		if (ai_steps != 0)
+			tick_enemies(tm.get_subsystem_dt(time_subsystem::ai) * ai_steps);
 	}
 
 	void gameplay::on_window_event(const window_event& ev, window* wnd)
@@ -54,6 +54,7 @@ namespace SFG
 		remove_mesh_instance,
 		create_entity,
 		remove_entity,
+		remove_entities,
 		update_entity_flags,
 		set_main_camera,
 		update_camera,
@@ -41,4 +41,17 @@ namespace SFG
 		stream >> is_template;
 		stream >> is_visible;
 	}
+
+	void render_event_entity_batch::serialize(ostream& stream) const
+	{
+		stream << count;
+		stream.write_raw(reinterpret_cast<const uint8*>(indices), sizeof(world_id) * count);
+	}
+
+	void render_event_entity_batch::deserialize(istream& stream)
+	{
+		stream >> count;
+		indices = reinterpret_cast<const world_id*>(stream.get_data_current());
+		stream.skip_by(sizeof(world_id) * count);
+	}
 }
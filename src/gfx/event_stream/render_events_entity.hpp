@@ -31,6 +31,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "math/matrix4x3.hpp"
 #include "math/vector3.hpp"
 #include "math/quat.hpp"
+#include "world/world_constants.hpp"
 
 namespace SFG
 {
@@ -46,4 +47,13 @@ namespace SFG
 		void deserialize(istream& stream);
 	};
 
+	struct render_event_entity_batch
+	{
+		const world_id* indices = nullptr;
+		uint32			count	= 0;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+
 }
@@ -237,6 +237,7 @@ namespace SFG
 		stream << root_index;
 		stream << nodes;
 		stream << matrices;
+		stream << radii;
 	}
 
 	void render_event_skin::deserialize(istream& stream)
@@ -244,6 +245,7 @@ namespace SFG
 		stream >> root_index;
 		stream >> nodes;
 		stream >> matrices;
+		stream >> radii;
 	}
 
 	void render_event_update_material_sampler::serialize(ostream& stream) const
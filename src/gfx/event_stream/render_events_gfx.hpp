@@ -180,6 +180,7 @@ namespace SFG
 	{
 		vector<uint16>	  nodes;
 		vector<matrix4x3> matrices;
+		vector<float>	  radii;
 		int16			  root_index = -1;
 
 		void serialize(ostream& stream) const;
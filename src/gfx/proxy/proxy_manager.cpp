@@ -207,6 +207,9 @@ namespace SFG
 		if (in.get_size() == 0)
 			return;
 
+		// events are consumed while the batch is alive, mesh data uploads straight from it.
+		in.set_persistent(true);
+
 		render_event_header header = {};
 
 		while (!in.is_eof())
@@ -401,6 +404,16 @@ namespace SFG
 			render_proxy_entity& proxy = get_entity(index);
 			proxy.status			   = render_proxy_status::rps_inactive;
 		}
+		else if (type == render_event_type::remove_entities)
+		{
+			render_event_entity_batch ev = {};
+			ev.deserialize(stream);
+			for (uint32 i = 0; i < ev.count; i++)
+			{
+				render_proxy_entity& proxy = get_entity(ev.indices[i]);
+				proxy.status			   = render_proxy_status::rps_inactive;
+			}
+		}
 		else if (type == render_event_type::update_entity_flags)
 		{
 			render_event_entity_flags ev = {};
@@ -1198,15 +1211,23 @@ namespace SFG
 			proxy.status			 = render_proxy_status::rps_active;
 			proxy.nodes				 = _aux_memory.allocate<uint16>(sz);
 			proxy.matrices			 = _aux_memory.allocate<matrix4x3>(sz);
+			proxy.radii				 = _aux_memory.allocate<float>(sz);
 			proxy.node_count		 = sz;
 
 			uint16*	   nodes	= _aux_memory.get<uint16>(proxy.nodes);
 			matrix4x3* matrices = _aux_memory.get<matrix4x3>(proxy.matrices);
+			float*	   radii	= _aux_memory.get<float>(proxy.radii);
+
+			const bool has_radii = ev.radii.size() == ev.nodes.size();
 
 			for (uint32 i = 0; i < sz; i++)
 			{
 				nodes[i]	= ev.nodes[i];
 				matrices[i] = ev.matrices[i];
+				radii[i]	= has_radii ? ev.radii[i] : 0.0f;
+
+				if (radii[i] > 0.0f)
+					proxy.has_bounds = 1;
 			}
 		}
 		else if (type == render_event_type::destroy_skin)
@@ -1445,6 +1466,13 @@ namespace SFG
 
 	void proxy_manager::destroy_skin(render_proxy_skin& proxy)
 	{
+		if (proxy.nodes.size != 0)
+			_aux_memory.free(proxy.nodes);
+		if (proxy.matrices.size != 0)
+			_aux_memory.free(proxy.matrices);
+		if (proxy.radii.size != 0)
+			_aux_memory.free(proxy.radii);
+
 		proxy = {};
 	}
 
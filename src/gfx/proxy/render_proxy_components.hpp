@@ -32,6 +32,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "resources/common_resources.hpp"
 
 // math
+#include "math/aabb.hpp"
 #include "math/color.hpp"
 #include "math/vector2ui16.hpp"
 #include "math/vector4ui16.hpp"
@@ -49,6 +50,7 @@ namespace SFG
 {
 	struct render_proxy_mesh_instance
 	{
+		aabb		   _animated_aabb		= {};
 		chunk_handle32 skin_entities		= {};
 		uint32		   _assigned_bone_index = 0;
 		world_id	   entity				= 0;
@@ -57,6 +59,7 @@ namespace SFG
 		resource_id	   skin					= NULL_RESOURCE_ID;
 		uint16		   skin_entities_count	= 0;
 		uint16		   materials_count		= 0;
+		uint8		   _has_animated_aabb	= 0;
 	};
 
 	struct render_proxy_camera
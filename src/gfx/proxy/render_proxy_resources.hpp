@@ -119,9 +119,11 @@ namespace SFG
 	{
 		chunk_handle32 nodes	  = {};
 		chunk_handle32 matrices	  = {};
+		chunk_handle32 radii	  = {};
 		uint16		   node_count = 0;
 		int16		   root_node  = -1;
 		uint8		   status	  = render_proxy_status::rps_inactive;
+		uint8		   has_bounds = 0;
 	};
 
 	struct render_proxy_particle_resource
@@ -62,8 +62,9 @@ namespace SFG
 			if (proxy_mesh.primitives.size == 0)
 				continue;
 
+			// skinned instances are tested with their world-space animated bounds when the skin provides joint radii.
 			const vector3		 pos = proxy_entity.model.get_translation();
-			const frustum_result res = frustum::test(target_view.view_frustum, proxy_mesh.local_aabb, proxy_entity.model.to_linear3x3(), pos);
+			const frustum_result res = mesh_instance._has_animated_aabb ? frustum::test(target_view.view_frustum, mesh_instance._animated_aabb) : frustum::test(target_view.view_frustum, proxy_mesh.local_aabb, proxy_entity.model.to_linear3x3(), pos);
 			if (res == frustum_result::outside)
 				continue;
 
@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "vector4.hpp"
+#include "serialization/stream_layout.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "vendor/nhlohmann/json_fwd.hpp"
@@ -113,4 +114,6 @@ namespace SFG
 	void from_json(const nlohmann::json& j, color& c);
 #endif
 
+	SFG_STREAM_LAYOUT_RAW(color, 16);
+
 } // namespace SFG
@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "vector3.hpp"
 #include "vector4.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -155,4 +156,6 @@ namespace SFG
 	{
 		return mat * scalar;
 	}
+
+	SFG_STREAM_LAYOUT_RAW(matrix4x4, 64);
 }
\ No newline at end of file
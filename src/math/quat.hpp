@@ -27,6 +27,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "vector3.hpp"
+#include "serialization/stream_layout.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "vendor/nhlohmann/json_fwd.hpp"
@@ -154,4 +155,6 @@ namespace SFG
 
 #endif
 
+	SFG_STREAM_LAYOUT_RAW(quat, 16);
+
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "math_common.hpp"
+#include "serialization/stream_layout.hpp"
 
 #undef min
 #undef max
@@ -147,4 +148,6 @@ namespace SFG
 	void from_json(const nlohmann::json& j, vector2& v);
 
 #endif
+
+	SFG_STREAM_LAYOUT_RAW(vector2, 8);
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "common/size_definitions.hpp"
+#include "serialization/stream_layout.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "vendor/nhlohmann/json_fwd.hpp"
@@ -69,4 +70,6 @@ namespace SFG
 
 #endif
 
+	SFG_STREAM_LAYOUT_RAW(vector2ui16, 4);
+
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "math_common.hpp"
+#include "serialization/stream_layout.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "vendor/nhlohmann/json_fwd.hpp"
@@ -188,4 +189,6 @@ namespace SFG
 	void from_json(const nlohmann::json& j, vector3& v);
 
 #endif
+
+	SFG_STREAM_LAYOUT_RAW(vector3, 12);
 }
\ No newline at end of file
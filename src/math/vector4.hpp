@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "math_common.hpp"
+#include "serialization/stream_layout.hpp"
 
 #undef min
 #undef max
@@ -170,4 +171,6 @@ namespace SFG
 
 #endif
 
+	SFG_STREAM_LAYOUT_RAW(vector4, 16);
+
 }
\ No newline at end of file
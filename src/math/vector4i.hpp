@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "common/size_definitions.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -61,4 +62,6 @@ namespace SFG
 		int32 w = 0;
 	};
 
+	SFG_STREAM_LAYOUT_RAW(vector4i, 16);
+
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 #include "common/size_definitions.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -50,4 +51,6 @@ namespace SFG
 		uint16 w = 0;
 	};
 
+	SFG_STREAM_LAYOUT_RAW(vector4ui16, 8);
+
 }
\ No newline at end of file
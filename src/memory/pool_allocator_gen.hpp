@@ -83,6 +83,26 @@ namespace SFG
 			};
 		}
 
+		void add(pool_handle<SIZE_TYPE>* out, uint32 count)
+		{
+			const uint32 from_free = count < static_cast<uint32>(_free_count) ? count : static_cast<uint32>(_free_count);
+			const uint32 from_head = count - from_free;
+			SFG_ASSERT(static_cast<uint32>(_head) + from_head <= static_cast<uint32>(N));
+
+			for (uint32 i = 0; i < count; i++)
+			{
+				const SIZE_TYPE index = i < from_free ? _free_list[_free_count - 1 - i] : static_cast<SIZE_TYPE>(_head + (i - from_free));
+				_items[index].~T();
+				new (&_items[index]) T();
+				_actives[index]	  = 1;
+				out[i].generation = _generations[index];
+				out[i].index	  = index;
+			}
+
+			_free_count -= static_cast<SIZE_TYPE>(from_free);
+			_head += static_cast<SIZE_TYPE>(from_head);
+		}
+
 		inline bool is_full() const
 		{
 			return _free_count == 0 && _head >= N;
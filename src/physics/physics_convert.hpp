@@ -30,6 +30,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "math/vector3.hpp"
 #include "math/quat.hpp"
 #include "math/color.hpp"
+#include "world/world_constants.hpp"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/Core/Color.h>
@@ -68,4 +69,18 @@ namespace SFG
 	{
 		return color(c.r, c.g, c.b, c.a);
 	}
+
+	// bodies and characters carry their entity handle in jolt user data, 0 reads back as a null handle.
+	static inline uint64 to_jph_user_data(world_handle h)
+	{
+		return (static_cast<uint64>(h.generation) << 32) | static_cast<uint64>(h.index);
+	}
+
+	static inline world_handle from_jph_user_data(uint64 packed)
+	{
+		world_handle h = {};
+		h.generation   = static_cast<uint32>(packed >> 32);
+		h.index		   = static_cast<uint32>(packed & 0xffffffff);
+		return h;
+	}
 }
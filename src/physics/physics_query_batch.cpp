@@ -0,0 +1,216 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "physics_query_batch.hpp"
+#include "physics_world.hpp"
+#include "physics/physics_convert.hpp"
+#include "io/assert.hpp"
+
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <execution>
+#include <tracy/Tracy.hpp>
+
+namespace SFG
+{
+	void physics_query_batch::init(uint32 capacity)
+	{
+		_capacity = capacity;
+		_count	  = 0;
+
+		_types.resize(capacity);
+		_positions.resize(capacity);
+		_normals.resize(capacity);
+		_max_distances.resize(capacity);
+		_radii.resize(capacity);
+
+		_hits.resize(capacity);
+		_hit_entities.resize(capacity);
+		_hit_points.resize(capacity);
+		_hit_normals.resize(capacity);
+		_hit_distances.resize(capacity);
+
+		_task_starts.reserve((capacity + QUERIES_PER_TASK - 1) / QUERIES_PER_TASK);
+	}
+
+	void physics_query_batch::uninit()
+	{
+		_types.clear();
+		_positions.clear();
+		_normals.clear();
+		_max_distances.clear();
+		_radii.clear();
+
+		_hits.clear();
+		_hit_entities.clear();
+		_hit_points.clear();
+		_hit_normals.clear();
+		_hit_distances.clear();
+
+		_task_starts.clear();
+		_capacity = 0;
+		_count	  = 0;
+	}
+
+	void physics_query_batch::reset()
+	{
+		_count = 0;
+	}
+
+	uint32 physics_query_batch::add_ray(const vector3& position, const vector3& normal, float max_distance)
+	{
+		return add_query(physics_query_type::ray, position, normal, max_distance, 0.0f);
+	}
+
+	uint32 physics_query_batch::add_sphere_cast(const vector3& position, const vector3& normal, float max_distance, float radius)
+	{
+		return add_query(physics_query_type::sphere_cast, position, normal, max_distance, radius);
+	}
+
+	uint32 physics_query_batch::add_overlap_sphere(const vector3& center, float radius)
+	{
+		return add_query(physics_query_type::overlap_sphere, center, vector3::zero, 0.0f, radius);
+	}
+
+	uint32 physics_query_batch::add_query(physics_query_type type, const vector3& position, const vector3& normal, float max_distance, float radius)
+	{
+		SFG_ASSERT(_count < _capacity);
+
+		const uint32 index	  = _count++;
+		_types[index]		  = type;
+		_positions[index]	  = position;
+		_normals[index]		  = normal;
+		_max_distances[index] = max_distance;
+		_radii[index]		  = radius;
+		return index;
+	}
+
+	void physics_query_batch::execute(physics_world& world)
+	{
+		ZoneScoped;
+
+		_task_starts.resize(0);
+		for (uint32 i = 0; i < _count; i += QUERIES_PER_TASK)
+			_task_starts.push_back(i);
+
+		std::for_each(std::execution::par, _task_starts.begin(), _task_starts.end(), [&](uint32 start) {
+			const uint32 end = std::min(start + QUERIES_PER_TASK, _count);
+			for (uint32 i = start; i < end; i++)
+			{
+				_hits[i]		  = 0;
+				_hit_entities[i]  = {};
+				_hit_points[i]	  = vector3::zero;
+				_hit_normals[i]	  = vector3::zero;
+				_hit_distances[i] = 0.0f;
+
+				const physics_query_type type = _types[i];
+				if (type == physics_query_type::ray)
+					execute_ray(world, i);
+				else if (type == physics_query_type::sphere_cast)
+					execute_sphere_cast(world, i);
+				else
+					execute_overlap_sphere(world, i);
+			}
+		});
+	}
+
+	void physics_query_batch::execute_ray(physics_world& world, uint32 index)
+	{
+		JPH::PhysicsSystem* system	  = world.get_system();
+		const vector3		direction = _normals[index] * _max_distances[index];
+		const JPH::RRayCast ray(to_jph_vec3(_positions[index]), to_jph_vec3(direction));
+		JPH::RayCastResult	hit;
+
+		if (!system->GetNarrowPhaseQuery().CastRay(ray, hit))
+			return;
+
+		const JPH::RVec3 point = ray.GetPointOnRay(hit.mFraction);
+
+		// surface normal needs the body shape, read lock keeps it valid while other tasks query.
+		JPH::BodyLockRead lock(system->GetBodyLockInterface(), hit.mBodyID);
+		if (lock.Succeeded())
+			_hit_normals[index] = from_jph_vec3(lock.GetBody().GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, point));
+
+		_hits[index]		  = 1;
+		_hit_entities[index]  = world.get_comp_physics_entity_by_id(hit.mBodyID);
+		_hit_points[index]	  = from_jph_vec3(point);
+		_hit_distances[index] = hit.mFraction * _max_distances[index];
+	}
+
+	void physics_query_batch::execute_sphere_cast(physics_world& world, uint32 index)
+	{
+		JPH::SphereShape sphere(_radii[index]);
+		sphere.SetEmbedded();
+
+		const JPH::RVec3	  origin	= to_jph_vec3(_positions[index]);
+		const vector3		  direction = _normals[index] * _max_distances[index];
+		const JPH::RShapeCast cast		= JPH::RShapeCast::sFromWorldTransform(&sphere, JPH::Vec3::sReplicate(1.0f), JPH::RMat44::sTranslation(origin), to_jph_vec3(direction));
+
+		JPH::ShapeCastSettings									   settings;
+		JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+		world.get_system()->GetNarrowPhaseQuery().CastShape(cast, settings, origin, collector);
+
+		if (!collector.HadHit())
+			return;
+
+		const JPH::ShapeCastResult& hit = collector.mHit;
+		_hits[index]					= 1;
+		_hit_entities[index]			= world.get_comp_physics_entity_by_id(hit.mBodyID2);
+		_hit_points[index]				= from_jph_vec3(origin + hit.mContactPointOn2);
+		_hit_normals[index]				= from_jph_vec3(-hit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+		_hit_distances[index]			= hit.mFraction * _max_distances[index];
+	}
+
+	void physics_query_batch::execute_overlap_sphere(physics_world& world, uint32 index)
+	{
+		JPH::SphereShape sphere(_radii[index]);
+		sphere.SetEmbedded();
+
+		const JPH::RVec3											  center = to_jph_vec3(_positions[index]);
+		JPH::CollideShapeSettings									  settings;
+		JPH::ClosestHitCollisionCollector<JPH::CollideShapeCollector> collector;
+		world.get_system()->GetNarrowPhaseQuery().CollideShape(&sphere, JPH::Vec3::sReplicate(1.0f), JPH::RMat44::sTranslation(center), settings, center, collector);
+
+		if (!collector.HadHit())
+			return;
+
+		// closest hit for overlaps is the deepest penetration, distance reports that depth.
+		const JPH::CollideShapeResult& hit = collector.mHit;
+		_hits[index]					   = 1;
+		_hit_entities[index]			   = world.get_comp_physics_entity_by_id(hit.mBodyID2);
+		_hit_points[index]				   = from_jph_vec3(center + hit.mContactPointOn2);
+		_hit_normals[index]				   = from_jph_vec3(-hit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero()));
+		_hit_distances[index]			   = hit.mPenetrationDepth;
+	}
+
+}
@@ -0,0 +1,137 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "data/vector.hpp"
+#include "math/vector3.hpp"
+#include "world/world_constants.hpp"
+
+namespace SFG
+{
+	class physics_world;
+
+	enum class physics_query_type : uint8
+	{
+		ray,
+		sphere_cast,
+		overlap_sphere,
+	};
+
+	/*
+	 * Collects rays, sphere casts and sphere overlaps, then runs them in parallel against the narrow phase.
+	 * Inputs and results are stored as parallel arrays sized once in init, so per-frame batches never allocate.
+	 * Each query reports its closest hit, overlaps report the deepest penetrating body.
+	 * Execute only outside of physics_world::simulate, queries take body read locks but the body set must not change.
+	 */
+	class physics_query_batch
+	{
+	public:
+		// -----------------------------------------------------------------------------
+		// lifecycle
+		// -----------------------------------------------------------------------------
+
+		void init(uint32 capacity);
+		void uninit();
+		void reset();
+		void execute(physics_world& world);
+
+		// -----------------------------------------------------------------------------
+		// queries
+		// -----------------------------------------------------------------------------
+
+		uint32 add_ray(const vector3& position, const vector3& normal, float max_distance);
+		uint32 add_sphere_cast(const vector3& position, const vector3& normal, float max_distance, float radius);
+		uint32 add_overlap_sphere(const vector3& center, float radius);
+
+		// -----------------------------------------------------------------------------
+		// results
+		// -----------------------------------------------------------------------------
+
+		inline uint32 get_count() const
+		{
+			return _count;
+		}
+
+		inline bool get_hit(uint32 index) const
+		{
+			return _hits[index] != 0;
+		}
+
+		inline const uint8* get_hits() const
+		{
+			return _hits.data();
+		}
+
+		inline const world_handle* get_hit_entities() const
+		{
+			return _hit_entities.data();
+		}
+
+		inline const vector3* get_hit_points() const
+		{
+			return _hit_points.data();
+		}
+
+		inline const vector3* get_hit_normals() const
+		{
+			return _hit_normals.data();
+		}
+
+		inline const float* get_hit_distances() const
+		{
+			return _hit_distances.data();
+		}
+
+	private:
+		static constexpr uint32 QUERIES_PER_TASK = 32;
+
+		uint32 add_query(physics_query_type type, const vector3& position, const vector3& normal, float max_distance, float radius);
+		void   execute_ray(physics_world& world, uint32 index);
+		void   execute_sphere_cast(physics_world& world, uint32 index);
+		void   execute_overlap_sphere(physics_world& world, uint32 index);
+
+	private:
+		// inputs
+		vector<physics_query_type> _types		  = {};
+		vector<vector3>			   _positions	  = {};
+		vector<vector3>			   _normals		  = {};
+		vector<float>			   _max_distances = {};
+		vector<float>			   _radii		  = {};
+
+		// outputs
+		vector<uint8>		 _hits			= {};
+		vector<world_handle> _hit_entities	= {};
+		vector<vector3>		 _hit_points	= {};
+		vector<vector3>		 _hit_normals	= {};
+		vector<float>		 _hit_distances = {};
+
+		vector<uint32> _task_starts = {};
+		uint32		   _count		= 0;
+		uint32		   _capacity	= 0;
+	};
+}
@@ -0,0 +1,88 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "data/vector.hpp"
+#include "world/world_constants.hpp"
+#include "world/entity_manager.hpp"
+
+namespace SFG
+{
+	struct physics_snapshot_header
+	{
+		uint32 transform_count = 0;
+		uint32 character_count = 0;
+		uint32 state_offset	   = 0;
+		uint32 state_size	   = 0;
+	};
+
+	struct physics_snapshot_transform
+	{
+		world_handle	 entity	   = {};
+		entity_transform transform = {};
+	};
+
+	/*
+	 * Flat physics snapshot: header, local transforms of physics driven entities, then jolt system and character state.
+	 * Plain bytes without pointers, so it can be copied, kept in a ring for rollback or sent over the wire as is.
+	 * Restoring requires the same bodies and controllers to exist as when it was saved.
+	 */
+	struct physics_snapshot
+	{
+		vector<uint8> data = {};
+
+		inline bool is_empty() const
+		{
+			return data.size() < sizeof(physics_snapshot_header);
+		}
+
+		/*
+		 * Header counts and ranges fit inside data, snapshots from the wire or a stale ring slot are checked before use.
+		 */
+		inline bool is_consistent() const
+		{
+			if (is_empty())
+				return false;
+
+			const physics_snapshot_header& header		  = get_header();
+			const uint64				   transforms_end = sizeof(physics_snapshot_header) + static_cast<uint64>(header.transform_count) * sizeof(physics_snapshot_transform);
+			const uint64				   state_end	  = static_cast<uint64>(header.state_offset) + header.state_size;
+			return transforms_end <= header.state_offset && state_end <= data.size();
+		}
+
+		inline const physics_snapshot_header& get_header() const
+		{
+			return *reinterpret_cast<const physics_snapshot_header*>(data.data());
+		}
+
+		inline const physics_snapshot_transform* get_transforms() const
+		{
+			return reinterpret_cast<const physics_snapshot_transform*>(data.data() + sizeof(physics_snapshot_header));
+		}
+	};
+}
@@ -0,0 +1,141 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "memory/memory.hpp"
+#include "io/assert.hpp"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/StreamIn.h>
+#include <Jolt/Core/StreamOut.h>
+#include <Jolt/Physics/StateRecorder.h>
+
+namespace SFG
+{
+	// jolt binary state writer appending into a byte vector.
+	class physics_stream_out final : public JPH::StreamOut
+	{
+	public:
+		explicit physics_stream_out(vector<uint8>& out) : _out(out) {};
+
+		virtual void WriteBytes(const void* inData, size_t inNumBytes) override
+		{
+			const uint8* src = static_cast<const uint8*>(inData);
+			_out.insert(_out.end(), src, src + inNumBytes);
+		}
+
+		virtual bool IsFailed() const override
+		{
+			return false;
+		}
+
+	private:
+		vector<uint8>& _out;
+	};
+
+	// jolt binary state reader over a raw memory block.
+	class physics_stream_in final : public JPH::StreamIn
+	{
+	public:
+		physics_stream_in(const uint8* data, size_t size) : _data(data), _size(size) {};
+
+		virtual void ReadBytes(void* outData, size_t inNumBytes) override
+		{
+			if (_cursor + inNumBytes > _size)
+			{
+				_failed = true;
+				_cursor = _size;
+				return;
+			}
+
+			SFG_MEMCPY(outData, _data + _cursor, inNumBytes);
+			_cursor += inNumBytes;
+		}
+
+		virtual bool IsEOF() const override
+		{
+			return _cursor >= _size;
+		}
+
+		virtual bool IsFailed() const override
+		{
+			return _failed;
+		}
+
+	private:
+		const uint8* _data	 = nullptr;
+		size_t		 _size	 = 0;
+		size_t		 _cursor = 0;
+		bool		 _failed = false;
+	};
+
+	// jolt state recorder, writes append to a byte vector and reads walk a raw memory block.
+	class physics_state_recorder final : public JPH::StateRecorder
+	{
+	public:
+		explicit physics_state_recorder(vector<uint8>& out) : _out(&out) {};
+		physics_state_recorder(const uint8* data, size_t size) : _data(data), _size(size) {};
+
+		virtual void WriteBytes(const void* inData, size_t inNumBytes) override
+		{
+			SFG_ASSERT(_out != nullptr);
+			const uint8* src = static_cast<const uint8*>(inData);
+			_out->insert(_out->end(), src, src + inNumBytes);
+		}
+
+		virtual void ReadBytes(void* outData, size_t inNumBytes) override
+		{
+			if (_cursor + inNumBytes > _size)
+			{
+				_failed = true;
+				_cursor = _size;
+				return;
+			}
+
+			SFG_MEMCPY(outData, _data + _cursor, inNumBytes);
+			_cursor += inNumBytes;
+		}
+
+		virtual bool IsEOF() const override
+		{
+			return _cursor >= _size;
+		}
+
+		virtual bool IsFailed() const override
+		{
+			return _failed;
+		}
+
+	private:
+		vector<uint8>* _out	   = nullptr;
+		const uint8*   _data   = nullptr;
+		size_t		   _size   = 0;
+		size_t		   _cursor = 0;
+		bool		   _failed = false;
+	};
+}
@@ -34,10 +34,13 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "physics/physics_bp_layer_interface.hpp"
 #include "physics/physics_world_contact_listener.hpp"
 #include "physics/physics_world_character_contact_listener.hpp"
+#include "physics/physics_snapshot.hpp"
+#include "physics/physics_stream.hpp"
 #include "resources/physical_material.hpp"
 #include "world/components/comp_physics.hpp"
 #include "world/components/comp_character_controller.hpp"
 #include "platform/time.hpp"
+#include "math/math.hpp"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
@@ -55,7 +58,9 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Jolt/Physics/Collision/Shape/PlaneShape.h>
 #include <Jolt/Physics/Collision/Shape/CylinderShape.h>
 #include <Jolt/Physics/Collision/Shape/ScaledShape.h>
+#include <algorithm>
 #include <regex>
+#include <execution>
 #include <stdarg.h>
 #include <tracy/Tracy.hpp>
 
@@ -97,6 +102,24 @@ namespace
 
 namespace SFG
 {
+	namespace
+	{
+		physics_step_pose begin_step_pose(const entity_manager& em, world_handle entity)
+		{
+			return {
+				.entity		   = entity,
+				.prev_position = em.get_entity_position(entity),
+				.prev_rotation = em.get_entity_rotation(entity),
+			};
+		}
+
+		void end_step_pose(const entity_manager& em, physics_step_pose& pose)
+		{
+			pose.position = em.get_entity_position(pose.entity);
+			pose.rotation = em.get_entity_rotation(pose.entity);
+		}
+	}
+
 	void physics_world::init()
 	{
 		JPH::RegisterDefaultAllocator();
@@ -117,7 +140,7 @@ namespace SFG
 		_contact_listener_adapter->set_listener(_contact_listener);
 		_character_contact_listener_adapter->set_listener(_character_contact_listener);
 
-		const uint32 cMaxBodies				= 1024;
+		const uint32 cMaxBodies				= MAX_BODIES;
 		const uint32 cNumBodyMutexes		= 0;
 		const uint32 cMaxBodyPairs			= 1024;
 		const uint32 cMaxContactConstraints = 1024;
@@ -125,6 +148,16 @@ namespace SFG
 		_system->SetContactListener(_contact_listener_adapter);
 		set_gravity(vector3(0.0f, -9.81f, 0.0f));
 		_added_bodies.reserve(MAX_ENTITIES);
+		_body_comps.resize(MAX_BODIES);
+		_step_poses.reserve(MAX_BODIES);
+
+		const uint32 character_tasks = std::max(1u, std::min(static_cast<uint32>(JPH::thread::hardware_concurrency()), MAX_CHARACTER_UPDATE_TASKS));
+		for (uint32 i = 0; i < character_tasks; i++)
+		{
+			_character_allocators.push_back(new JPH::TempAllocatorImpl(CHARACTER_ALLOCATOR_SIZE));
+			_character_tasks.push_back(i);
+		}
+		_character_updates.reserve(MAX_WORLD_COMP_CHARACTER_CONTROLLERS);
 	}
 
 	void physics_world::uninit()
@@ -139,6 +172,11 @@ namespace SFG
 		delete _object_bp_layer_filter;
 		delete _bp_layer_interface;
 
+		for (JPH::TempAllocatorImpl* alloc : _character_allocators)
+			delete alloc;
+		_character_allocators.clear();
+		_character_tasks.clear();
+
 		_layer_filter						= nullptr;
 		_object_bp_layer_filter				= nullptr;
 		_bp_layer_interface					= nullptr;
@@ -195,6 +233,8 @@ namespace SFG
 		if (!reuse_body_ids.empty())
 			body_interface.RemoveBodies(reuse_body_ids.data(), static_cast<int32>(reuse_body_ids.size()));
 
+		_step_poses.resize(0);
+
 		cm.view<comp_physics>([this](comp_physics& c) -> comp_view_result {
 			c.destroy_body(_game_world);
 			return comp_view_result::cont;
@@ -206,39 +246,111 @@ namespace SFG
 		ZoneScoped;
 		constexpr int collision_steps = 2;
 
-#if !FIXED_FRAMERATE_ENABLED
-		const float used_rate = PHYSICS_RATE_WITHOUT_FIXED_FRAMERATE_S;
-		if (_dt_counter < used_rate)
-		{
-			_dt_counter += rate;
-			return;
-		}
-		_dt_counter -= used_rate;
-#else
+		// stepping cadence is owned by the time_manager physics schedule, rate is always one fixed step.
 		const float used_rate = rate;
-#endif
 
 		_system->Update(used_rate, collision_steps, _allocator, _job_system);
 
+		// poses of the entities moved by this step, rendering blends them at physics rate instead of tick rate.
+		_step_poses.resize(0);
+
 		component_manager& cm = _game_world.get_comp_manager();
 		entity_manager&	   em = _game_world.get_entity_manager();
 
-		auto& controllers = cm.underlying_pool<comp_cache<comp_character_controller, MAX_WORLD_COMP_CHARACTER_CONTROLLERS>, comp_character_controller>();
-		for (comp_character_controller& c : controllers)
-			c.update(_game_world, used_rate);
+		update_character_controllers(used_rate);
+
+		// only bodies jolt still considers awake can have moved, sleeping and static ones keep their entity transforms.
+		// the list is stable here as no jobs are running after Update.
+		const JPH::BodyID* active_bodies = _system->GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+		const uint32	   active_count	 = _system->GetNumActiveBodies(JPH::EBodyType::RigidBody);
 
-		auto& phys = cm.underlying_pool<comp_cache<comp_physics, MAX_WORLD_COMP_PHYSICS>, comp_physics>();
-		for (comp_physics& c : phys)
+		for (uint32 i = 0; i < active_count; i++)
 		{
-			JPH::Body* body = c.get_body();
+			const world_handle comp_handle = _body_comps[active_bodies[i].GetIndex()];
+			if (comp_handle.is_null())
+				continue;
+
+			comp_physics& c	   = cm.get_component<comp_physics>(comp_handle);
+			JPH::Body*	  body = c.get_body();
 			SFG_ASSERT(body != nullptr);
 
 			const world_handle e_handle		= c.get_header().entity;
 			const quat		   body_rot		= from_jph_quat(body->GetRotation());
 			const vector3	   scale		= em.get_entity_scale_abs(e_handle);
 			const vector3	   offset_world = body_rot * (c.get_offset() * scale);
+
+			physics_step_pose pose = begin_step_pose(em, e_handle);
 			em.set_entity_position_abs(e_handle, from_jph_vec3(body->GetPosition()) - offset_world);
 			em.set_entity_rotation_abs(e_handle, body_rot);
+			end_step_pose(em, pose);
+			_step_poses.push_back(pose);
+		}
+	}
+
+#if FIXED_FRAMERATE_ENABLED && FIXED_FRAMERATE_USE_INTERPOLATION
+
+	void physics_world::interpolate_bodies(float alpha)
+	{
+		ZoneScoped;
+
+		// runs after the entity interpolation, bodies that slept through the last step keep the tick blend.
+		entity_manager& em = _game_world.get_entity_manager();
+		const float		t  = math::clamp(alpha, 0.0f, 1.0f);
+
+		for (const physics_step_pose& pose : _step_poses)
+		{
+			if (!em.is_valid(pose.entity))
+				continue;
+
+			em.set_entity_render_transform(pose.entity, vector3::lerp(pose.prev_position, pose.position, t), quat::slerp(pose.prev_rotation, pose.rotation, t));
+		}
+	}
+
+#endif
+
+	void physics_world::flush_contacts()
+	{
+		// contacts gathered on jolt workers during the steps are dispatched here, outside of any frame task,
+		// gameplay listeners may touch any entity, component or the render stream.
+		_contact_listener_adapter->flush();
+		_character_contact_listener_adapter->flush();
+	}
+
+	void physics_world::update_character_controllers(float dt)
+	{
+		ZoneScoped;
+
+		component_manager& cm		   = _game_world.get_comp_manager();
+		auto&			   controllers = cm.underlying_pool<comp_cache<comp_character_controller, MAX_WORLD_COMP_CHARACTER_CONTROLLERS>, comp_character_controller>();
+
+		// lazy controller creation registers with jolt, keep it serial.
+		_character_updates.resize(0);
+		for (comp_character_controller& c : controllers)
+		{
+			if (c.prepare_update(_game_world, dt))
+				_character_updates.push_back(&c);
+		}
+
+		const uint32 count = static_cast<uint32>(_character_updates.size());
+		if (count == 0)
+			return;
+
+		// controllers don't collide with each other, each step only reads the body set under body locks.
+		// every task strides over the list with its own temp allocator, contacts go through the buffered adapter.
+		const uint32 task_count = std::min(count, static_cast<uint32>(_character_tasks.size()));
+		std::for_each(std::execution::par, _character_tasks.begin(), _character_tasks.begin() + task_count, [&](uint32 task) {
+			JPH::TempAllocatorImpl& allocator = *_character_allocators[task];
+			for (uint32 i = task; i < count; i += task_count)
+				_character_updates[i]->update(_game_world, dt, allocator);
+		});
+
+		entity_manager& em = _game_world.get_entity_manager();
+		for (comp_character_controller* c : _character_updates)
+		{
+			physics_step_pose pose = begin_step_pose(em, c->get_header().entity);
+			c->write_back(_game_world);
+			end_step_pose(em, pose);
+			_step_poses.push_back(pose);
 		}
 	}
 
@@ -274,8 +386,7 @@ namespace SFG
 		if (controller == nullptr)
 			return;
 
-		const uint64 packed = (static_cast<uint64>(entity.generation) << 32) | static_cast<uint64>(entity.index);
-		controller->SetUserData(packed);
+		controller->SetUserData(to_jph_user_data(entity));
 		controller->SetListener(_character_contact_listener != nullptr ? _character_contact_listener_adapter : nullptr);
 	}
 
@@ -288,6 +399,120 @@ namespace SFG
 		controller->SetUserData(0);
 	}
 
+	void physics_world::save_snapshot(physics_snapshot& snapshot)
+	{
+		ZoneScoped;
+
+		component_manager& cm		   = _game_world.get_comp_manager();
+		entity_manager&	   em		   = _game_world.get_entity_manager();
+		auto&			   controllers = cm.underlying_pool<comp_cache<comp_character_controller, MAX_WORLD_COMP_CHARACTER_CONTROLLERS>, comp_character_controller>();
+		vector<uint8>&	   data		   = snapshot.data;
+
+		physics_snapshot_header header = {};
+		data.resize(sizeof(physics_snapshot_header));
+
+		auto push_transform = [&](world_handle entity) {
+			physics_snapshot_transform t = {.entity = entity};
+			t.transform.position		 = em.get_entity_position(entity);
+			t.transform.rotation		 = em.get_entity_rotation(entity);
+			t.transform.scale			 = em.get_entity_scale(entity);
+
+			const uint8* src = reinterpret_cast<const uint8*>(&t);
+			data.insert(data.end(), src, src + sizeof(physics_snapshot_transform));
+			header.transform_count++;
+		};
+
+		cm.view<comp_physics>([&](comp_physics& c) -> comp_view_result {
+			if (c.get_body() != nullptr)
+				push_transform(c.get_header().entity);
+			return comp_view_result::cont;
+		});
+
+		for (comp_character_controller& c : controllers)
+		{
+			if (c.get_controller() != nullptr)
+				push_transform(c.get_header().entity);
+		}
+
+		header.state_offset = static_cast<uint32>(data.size());
+
+		physics_state_recorder recorder(data);
+		_system->SaveState(recorder);
+
+		for (comp_character_controller& c : controllers)
+		{
+			JPH::CharacterVirtual* controller = c.get_controller();
+			if (controller == nullptr)
+				continue;
+			controller->SaveState(recorder);
+			header.character_count++;
+		}
+
+		header.state_size = static_cast<uint32>(data.size()) - header.state_offset;
+		SFG_MEMCPY(data.data(), &header, sizeof(physics_snapshot_header));
+	}
+
+	bool physics_world::restore_snapshot(const physics_snapshot& snapshot)
+	{
+		ZoneScoped;
+
+		if (!snapshot.is_consistent())
+		{
+			SFG_ERR("Physics snapshot is truncated or corrupt.");
+			return false;
+		}
+
+		component_manager&			   cm		   = _game_world.get_comp_manager();
+		entity_manager&				   em		   = _game_world.get_entity_manager();
+		auto&						   controllers = cm.underlying_pool<comp_cache<comp_character_controller, MAX_WORLD_COMP_CHARACTER_CONTROLLERS>, comp_character_controller>();
+		const physics_snapshot_header& header	   = snapshot.get_header();
+
+		uint32 character_count = 0;
+		for (comp_character_controller& c : controllers)
+		{
+			if (c.get_controller() != nullptr)
+				character_count++;
+		}
+
+		if (character_count != header.character_count)
+		{
+			SFG_ERR("Physics snapshot has {0} character controllers, world has {1}.", header.character_count, character_count);
+			return false;
+		}
+
+		physics_state_recorder recorder(snapshot.data.data() + header.state_offset, header.state_size);
+		if (!_system->RestoreState(recorder))
+		{
+			SFG_ERR("Physics snapshot doesn't match the bodies in the world.");
+			return false;
+		}
+
+		for (comp_character_controller& c : controllers)
+		{
+			JPH::CharacterVirtual* controller = c.get_controller();
+			if (controller != nullptr)
+				controller->RestoreState(recorder);
+		}
+
+		// restored entities are teleported, nothing blends from the last step into them.
+		_step_poses.resize(0);
+
+		const physics_snapshot_transform* transforms = snapshot.get_transforms();
+		for (uint32 i = 0; i < header.transform_count; i++)
+		{
+			const physics_snapshot_transform& t = transforms[i];
+			if (!em.is_valid(t.entity))
+				continue;
+
+			em.set_entity_position(t.entity, t.transform.position);
+			em.set_entity_rotation(t.entity, t.transform.rotation);
+			em.set_entity_scale(t.entity, t.transform.scale);
+			em.teleport_entity(t.entity);
+		}
+
+		return !recorder.IsFailed();
+	}
+
 	void physics_world::add_bodies_to_world(JPH::BodyID* body_ids, uint32 count)
 	{
 		JPH::BodyInterface&				   body_interface = _system->GetBodyInterface();
@@ -321,6 +546,16 @@ namespace SFG
 	{
 		JPH::BodyInterface& body_interface = _system->GetBodyInterface();
 		body_interface.RemoveBodies(body_ids, static_cast<int>(count));
+
+		// single compaction pass over the tracked ids instead of one erase per body.
+		static vector<uint32> reuse_removed;
+		reuse_removed.resize(count);
+		for (uint32 i = 0; i < count; i++)
+			reuse_removed[i] = body_ids[i].GetIndexAndSequenceNumber();
+		std::sort(reuse_removed.begin(), reuse_removed.end());
+
+		auto it = std::remove_if(_added_bodies.begin(), _added_bodies.end(), [](uint32 id) -> bool { return std::binary_search(reuse_removed.begin(), reuse_removed.end(), id); });
+		_added_bodies.erase(it, _added_bodies.end());
 	}
 
 	JPH::Body* physics_world::create_body(physics_body_type body_type, physics_shape_type shape, const vector3& extents_or_rad_height, resource_handle mat, bool is_sensor, const vector3& pos, const quat& rot, const vector3& scale, JPH::Shape* mesh_shape)
@@ -416,10 +651,19 @@ namespace SFG
 
 	void physics_world::destroy_body(JPH::Body* body)
 	{
+		_body_comps[body->GetID().GetIndex()] = {};
+
 		JPH::BodyInterface& body_interface = _system->GetBodyInterface();
 		body_interface.DestroyBody(body->GetID());
 	}
 
+	void physics_world::bind_body_comp(const JPH::Body& body, world_handle comp)
+	{
+		const uint32 index = body.GetID().GetIndex();
+		SFG_ASSERT(index < MAX_BODIES);
+		_body_comps[index] = comp;
+	}
+
 	void physics_world::set_gravity(const vector3& g)
 	{
 		_graivty = g;
@@ -428,35 +672,18 @@ namespace SFG
 
 	world_handle physics_world::get_comp_physics_entity_by_id(JPH::BodyID id)
 	{
-		component_manager& cm = _game_world.get_comp_manager();
-
-		auto& phys = cm.underlying_pool<comp_cache<comp_physics, MAX_WORLD_COMP_PHYSICS>, comp_physics>();
-		for (comp_physics& c : phys)
-		{
-			JPH::Body* body = c.get_body();
-			if (!body)
-				continue;
-			if (body->GetID() == id)
-				return c.get_header().entity;
-		}
+		if (id.IsInvalid())
+			return {};
 
-		return {};
+		return from_jph_user_data(_system->GetBodyInterfaceNoLock().GetUserData(id));
 	}
+
 	world_handle physics_world::get_comp_physics_by_id(JPH::BodyID id)
 	{
-		component_manager& cm = _game_world.get_comp_manager();
-
-		auto& phys = cm.underlying_pool<comp_cache<comp_physics, MAX_WORLD_COMP_PHYSICS>, comp_physics>();
-		for (comp_physics& c : phys)
-		{
-			JPH::Body* body = c.get_body();
-			if (!body)
-				continue;
-			if (body->GetID() == id)
-				return c.get_header().own_handle;
-		}
+		if (id.IsInvalid())
+			return {};
 
-		return {};
+		return _body_comps[id.GetIndex()];
 	}
 
 }
\ No newline at end of file
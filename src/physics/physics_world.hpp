@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "data/vector.hpp"
 #include "math/vector3.hpp"
+#include "math/quat.hpp"
 #include "physics/physics_material_settings.hpp"
 #include "physics/physics_types.hpp"
 #include "physics/physics_layer_filter.hpp"
@@ -53,7 +54,6 @@ namespace JPH
 namespace SFG
 {
 	class world;
-	class quat;
 	class physics_contact_listener;
 	class physics_world_contact_listener;
 	class physics_character_contact_listener;
@@ -63,10 +63,26 @@ namespace SFG
 	class physics_object_bp_layer_filter;
 	class physics_bp_layer_interface;
 	class physics_contact_listener;
+	class comp_character_controller;
+	struct physics_snapshot;
+
+	// local transform of a body's entity before and after the last physics step it moved in.
+	struct physics_step_pose
+	{
+		world_handle entity		   = {};
+		vector3		 prev_position = vector3::zero;
+		vector3		 position	   = vector3::zero;
+		quat		 prev_rotation = quat::identity;
+		quat		 rotation	   = quat::identity;
+	};
 
 	class physics_world
 	{
 	public:
+		static constexpr uint32 MAX_BODIES				   = 1024;
+		static constexpr uint32 MAX_CHARACTER_UPDATE_TASKS = 8;
+		static constexpr size_t CHARACTER_ALLOCATOR_SIZE   = 1024 * 1024;
+
 		physics_world() = delete;
 		physics_world(world& w) : _game_world(w) {};
 
@@ -79,10 +95,16 @@ namespace SFG
 		void init_simulation();
 		void uninit_simulation();
 		void simulate(float rate);
+		void flush_contacts();
+#if FIXED_FRAMERATE_ENABLED && FIXED_FRAMERATE_USE_INTERPOLATION
+		void interpolate_bodies(float alpha);
+#endif
 		void set_contact_listener(physics_contact_listener* listener);
 		void set_character_contact_listener(physics_character_contact_listener* listener);
 		void register_character_controller(JPH::CharacterVirtual* controller, world_handle entity);
 		void unregister_character_controller(JPH::CharacterVirtual* controller);
+		void save_snapshot(physics_snapshot& snapshot);
+		bool restore_snapshot(const physics_snapshot& snapshot);
 
 		// -----------------------------------------------------------------------------
 		// impl
@@ -93,6 +115,7 @@ namespace SFG
 		void		 remove_bodies_from_world(JPH::BodyID* body_ids, uint32 count);
 		JPH::Body*	 create_body(physics_body_type body_type, physics_shape_type shape, const vector3& extents_or_rad_height, resource_handle physical_material, bool is_sensor, const vector3& pos, const quat& rot, const vector3& scale, JPH::Shape* mesh_shape);
 		void		 destroy_body(JPH::Body* body);
+		void		 bind_body_comp(const JPH::Body& body, world_handle comp);
 		void		 set_gravity(const vector3& g);
 		world_handle get_comp_physics_entity_by_id(JPH::BodyID id);
 		world_handle get_comp_physics_by_id(JPH::BodyID id);
@@ -136,12 +159,17 @@ namespace SFG
 			return _default_material;
 		}
 
+	private:
+		void update_character_controllers(float dt);
+
 	private:
 		JPH::PhysicsSystem*		_system		= nullptr;
 		JPH::TempAllocatorImpl* _allocator	= nullptr;
 		JPH::JobSystem*			_job_system = nullptr;
 
 		vector<uint32>			   _added_bodies = {};
+		vector<world_handle>	   _body_comps	 = {};
+		vector<physics_step_pose>  _step_poses	 = {};
 		world&					   _game_world;
 		physical_material_settings _default_material = {};
 		vector3					   _graivty			 = vector3::zero;
@@ -154,8 +182,8 @@ namespace SFG
 		physics_world_character_contact_listener* _character_contact_listener_adapter = nullptr;
 		physics_character_contact_listener*		  _character_contact_listener		  = nullptr;
 
-#if !USE_FIXED_FRAMERATE
-		float _dt_counter = 0.0f;
-#endif
+		vector<JPH::TempAllocatorImpl*>	   _character_allocators = {};
+		vector<uint32>					   _character_tasks		 = {};
+		vector<comp_character_controller*> _character_updates	 = {};
 	};
 }
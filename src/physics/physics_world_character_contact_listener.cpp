@@ -28,12 +28,22 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "physics/physics_world.hpp"
 #include "physics/physics_character_contact_listener.hpp"
 #include "physics/physics_convert.hpp"
-#include "math/vector3.hpp"
+#include "game/game_max_defines.hpp"
+#include "io/log.hpp"
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <tracy/Tracy.hpp>
 
 namespace SFG
 {
 	physics_world_character_contact_listener::physics_world_character_contact_listener(physics_world& world) : _world(world)
 	{
+		_events = new physics_character_contact_event[MAX_PHYSICS_CHARACTER_CONTACT_EVENTS];
+	}
+
+	physics_world_character_contact_listener::~physics_world_character_contact_listener()
+	{
+		delete[] _events;
+		_events = nullptr;
 	}
 
 	void physics_world_character_contact_listener::set_listener(physics_character_contact_listener* listener)
@@ -41,6 +51,31 @@ namespace SFG
 		_listener = listener;
 	}
 
+	void physics_world_character_contact_listener::flush()
+	{
+		ZoneScoped;
+
+		const uint32 pushed = _event_count.exchange(0, std::memory_order_acquire);
+		if (_listener == nullptr)
+			return;
+
+		const uint32 count = pushed < MAX_PHYSICS_CHARACTER_CONTACT_EVENTS ? pushed : MAX_PHYSICS_CHARACTER_CONTACT_EVENTS;
+		if (count != pushed)
+			SFG_WARN("dropped {0} character contact events, grow MAX_PHYSICS_CHARACTER_CONTACT_EVENTS!", pushed - count);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const physics_character_contact_event& ev = _events[i];
+
+			if (ev.type == physics_character_contact_event_type::begin)
+				_listener->on_character_contact_begin(ev.character, ev.other, ev.position, ev.normal);
+			else if (ev.type == physics_character_contact_event_type::persist)
+				_listener->on_character_contact(ev.character, ev.other, ev.position, ev.normal);
+			else
+				_listener->on_character_contact_end(ev.character, ev.other);
+		}
+	}
+
 	void physics_world_character_contact_listener::OnContactAdded(const JPH::CharacterVirtual* inCharacter,
 																  const JPH::BodyID& inBodyID2,
 																  const JPH::SubShapeID& inSubShapeID2,
@@ -50,7 +85,7 @@ namespace SFG
 	{
 		(void)inSubShapeID2;
 		(void)ioSettings;
-		dispatch_contact_begin(inCharacter, inBodyID2, inContactPosition, inContactNormal);
+		push_contact(inCharacter, inBodyID2, inContactPosition, inContactNormal, physics_character_contact_event_type::begin);
 	}
 
 	void physics_world_character_contact_listener::OnContactPersisted(const JPH::CharacterVirtual* inCharacter,
@@ -62,7 +97,7 @@ namespace SFG
 	{
 		(void)inSubShapeID2;
 		(void)ioSettings;
-		dispatch_contact(inCharacter, inBodyID2, inContactPosition, inContactNormal);
+		push_contact(inCharacter, inBodyID2, inContactPosition, inContactNormal, physics_character_contact_event_type::persist);
 	}
 
 	void physics_world_character_contact_listener::OnContactRemoved(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, const JPH::SubShapeID& inSubShapeID2)
@@ -71,23 +106,15 @@ namespace SFG
 		if (_listener == nullptr || inCharacter == nullptr)
 			return;
 
-		world_handle character = unpack_world_handle(inCharacter->GetUserData());
+		const world_handle character = from_jph_user_data(inCharacter->GetUserData());
 		if (character.is_null())
 			return;
 
-		world_handle other = _world.get_comp_physics_entity_by_id(inBodyID2);
+		const world_handle other = from_jph_user_data(_world.get_system()->GetBodyInterfaceNoLock().GetUserData(inBodyID2));
 		if (other.is_null())
 			return;
 
-		_listener->on_character_contact_end(character, other);
-	}
-
-	world_handle physics_world_character_contact_listener::unpack_world_handle(uint64 packed)
-	{
-		world_handle h = {};
-		h.generation   = static_cast<uint32>(packed >> 32);
-		h.index		   = static_cast<uint32>(packed & 0xffffffff);
-		return h;
+		push_event({.character = character, .other = other, .type = physics_character_contact_event_type::end});
 	}
 
 	vector3 physics_world_character_contact_listener::to_vector3(const JPH::RVec3& v)
@@ -95,39 +122,32 @@ namespace SFG
 		return vector3(static_cast<float>(v.GetX()), static_cast<float>(v.GetY()), static_cast<float>(v.GetZ()));
 	}
 
-	void physics_world_character_contact_listener::dispatch_contact_begin(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal)
+	void physics_world_character_contact_listener::push_contact(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal, physics_character_contact_event_type type)
 	{
 		if (_listener == nullptr || inCharacter == nullptr)
 			return;
 
-		world_handle character = unpack_world_handle(inCharacter->GetUserData());
+		const world_handle character = from_jph_user_data(inCharacter->GetUserData());
 		if (character.is_null())
 			return;
 
-		world_handle other = _world.get_comp_physics_entity_by_id(inBodyID2);
+		const world_handle other = from_jph_user_data(_world.get_system()->GetBodyInterfaceNoLock().GetUserData(inBodyID2));
 		if (other.is_null())
 			return;
 
-		const vector3 pos	 = to_vector3(inContactPosition);
-		const vector3 normal = from_jph_vec3(inContactNormal);
-		_listener->on_character_contact_begin(character, other, pos, normal);
+		push_event({
+			.position  = to_vector3(inContactPosition),
+			.normal	   = from_jph_vec3(inContactNormal),
+			.character = character,
+			.other	   = other,
+			.type	   = type,
+		});
 	}
 
-	void physics_world_character_contact_listener::dispatch_contact(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal)
+	void physics_world_character_contact_listener::push_event(const physics_character_contact_event& ev)
 	{
-		if (_listener == nullptr || inCharacter == nullptr)
-			return;
-
-		world_handle character = unpack_world_handle(inCharacter->GetUserData());
-		if (character.is_null())
-			return;
-
-		world_handle other = _world.get_comp_physics_entity_by_id(inBodyID2);
-		if (other.is_null())
-			return;
-
-		const vector3 pos	 = to_vector3(inContactPosition);
-		const vector3 normal = from_jph_vec3(inContactNormal);
-		_listener->on_character_contact(character, other, pos, normal);
+		const uint32 slot = _event_count.fetch_add(1, std::memory_order_relaxed);
+		if (slot < MAX_PHYSICS_CHARACTER_CONTACT_EVENTS)
+			_events[slot] = ev;
 	}
 }
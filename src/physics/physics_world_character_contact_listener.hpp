@@ -27,6 +27,8 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "world/world_constants.hpp"
+#include "math/vector3.hpp"
+#include "data/atomic.hpp"
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Character/CharacterVirtual.h>
 
@@ -42,27 +44,47 @@ namespace SFG
 {
 	class physics_world;
 	class physics_character_contact_listener;
-	struct vector3;
+
+	enum class physics_character_contact_event_type : uint8
+	{
+		begin,
+		persist,
+		end,
+	};
+
+	struct physics_character_contact_event
+	{
+		vector3								 position  = vector3::zero;
+		vector3								 normal	   = vector3::zero;
+		world_handle						 character = {};
+		world_handle						 other	   = {};
+		physics_character_contact_event_type type	   = physics_character_contact_event_type::begin;
+	};
 
 	class physics_world_character_contact_listener final : public JPH::CharacterContactListener
 	{
 	public:
 		explicit physics_world_character_contact_listener(physics_world& world);
+		~physics_world_character_contact_listener();
 
 		void set_listener(physics_character_contact_listener* listener);
 
+		// dispatches contacts buffered during the last character updates on the calling thread.
+		void flush();
+
 		void OnContactAdded(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, const JPH::SubShapeID& inSubShapeID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal, JPH::CharacterContactSettings& ioSettings) override;
 		void OnContactPersisted(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, const JPH::SubShapeID& inSubShapeID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal, JPH::CharacterContactSettings& ioSettings) override;
 		void OnContactRemoved(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, const JPH::SubShapeID& inSubShapeID2) override;
 
 	private:
-		static world_handle unpack_world_handle(uint64 packed);
-		static vector3		to_vector3(const JPH::RVec3& v);
+		static vector3 to_vector3(const JPH::RVec3& v);
 
-		void dispatch_contact_begin(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal);
-		void dispatch_contact(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal);
+		void push_contact(const JPH::CharacterVirtual* inCharacter, const JPH::BodyID& inBodyID2, JPH::RVec3Arg inContactPosition, JPH::Vec3Arg inContactNormal, physics_character_contact_event_type type);
+		void push_event(const physics_character_contact_event& ev);
 
 		physics_world&						_world;
-		physics_character_contact_listener* _listener = nullptr;
+		physics_character_contact_listener* _listener	 = nullptr;
+		physics_character_contact_event*	_events		 = nullptr;
+		atomic<uint32>						_event_count = 0;
 	};
 }
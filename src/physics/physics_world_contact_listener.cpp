@@ -23,17 +23,27 @@ OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGEN
 OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
 OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-
 #include "physics/physics_world_contact_listener.hpp"
 #include "physics/physics_world.hpp"
 #include "physics/physics_contact_listener.hpp"
-#include "math/vector3.hpp"
+#include "physics/physics_convert.hpp"
+#include "game/game_max_defines.hpp"
+#include "io/log.hpp"
 #include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <tracy/Tracy.hpp>
 
 namespace SFG
 {
 	physics_world_contact_listener::physics_world_contact_listener(physics_world& world) : _world(world)
 	{
+		_events = new physics_contact_event[MAX_PHYSICS_CONTACT_EVENTS];
+	}
+
+	physics_world_contact_listener::~physics_world_contact_listener()
+	{
+		delete[] _events;
+		_events = nullptr;
 	}
 
 	void physics_world_contact_listener::set_listener(physics_contact_listener* listener)
@@ -41,16 +51,41 @@ namespace SFG
 		_listener = listener;
 	}
 
+	void physics_world_contact_listener::flush()
+	{
+		ZoneScoped;
+
+		const uint32 pushed = _event_count.exchange(0, std::memory_order_acquire);
+		if (_listener == nullptr)
+			return;
+
+		const uint32 count = pushed < MAX_PHYSICS_CONTACT_EVENTS ? pushed : MAX_PHYSICS_CONTACT_EVENTS;
+		if (count != pushed)
+			SFG_WARN("dropped {0} physics contact events, grow MAX_PHYSICS_CONTACT_EVENTS!", pushed - count);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const physics_contact_event& ev = _events[i];
+
+			if (ev.type == physics_contact_event_type::begin)
+				_listener->on_contact_begin(ev.e1, ev.e2, ev.p1, ev.p2);
+			else if (ev.type == physics_contact_event_type::persist)
+				_listener->on_contact(ev.e1, ev.e2, ev.p1, ev.p2);
+			else
+				_listener->on_contact_end(ev.e1, ev.e2);
+		}
+	}
+
 	void physics_world_contact_listener::OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings)
 	{
 		(void)ioSettings;
-		dispatch_contact_begin(inBody1, inBody2, inManifold);
+		push_contact(inBody1, inBody2, inManifold, physics_contact_event_type::begin);
 	}
 
 	void physics_world_contact_listener::OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings)
 	{
 		(void)ioSettings;
-		dispatch_contact(inBody1, inBody2, inManifold);
+		push_contact(inBody1, inBody2, inManifold, physics_contact_event_type::persist);
 	}
 
 	void physics_world_contact_listener::OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair)
@@ -58,12 +93,14 @@ namespace SFG
 		if (_listener == nullptr)
 			return;
 
-		world_handle e1 = _world.get_comp_physics_entity_by_id(inSubShapePair.GetBody1ID());
-		world_handle e2 = _world.get_comp_physics_entity_by_id(inSubShapePair.GetBody2ID());
+		// bodies are not locked here and might be gone already, user data reads as 0 then.
+		const JPH::BodyInterface& body_interface = _world.get_system()->GetBodyInterfaceNoLock();
+		const world_handle		  e1			 = from_jph_user_data(body_interface.GetUserData(inSubShapePair.GetBody1ID()));
+		const world_handle		  e2			 = from_jph_user_data(body_interface.GetUserData(inSubShapePair.GetBody2ID()));
 		if (e1.is_null() || e2.is_null())
 			return;
 
-		_listener->on_contact_end(e1, e2);
+		push_event({.e1 = e1, .e2 = e2, .type = physics_contact_event_type::end});
 	}
 
 	vector3 physics_world_contact_listener::to_vector3(const JPH::RVec3& v)
@@ -71,33 +108,30 @@ namespace SFG
 		return vector3(static_cast<float>(v.GetX()), static_cast<float>(v.GetY()), static_cast<float>(v.GetZ()));
 	}
 
-	void physics_world_contact_listener::dispatch_contact_begin(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold)
+	void physics_world_contact_listener::push_contact(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, physics_contact_event_type type)
 	{
 		if (_listener == nullptr)
 			return;
 
-		world_handle e1 = _world.get_comp_physics_entity_by_id(inBody1.GetID());
-		world_handle e2 = _world.get_comp_physics_entity_by_id(inBody2.GetID());
+		const world_handle e1 = from_jph_user_data(inBody1.GetUserData());
+		const world_handle e2 = from_jph_user_data(inBody2.GetUserData());
 		if (e1.is_null() || e2.is_null())
 			return;
 
-		const vector3 p1 = to_vector3(inManifold.GetWorldSpaceContactPointOn1(0));
-		const vector3 p2 = to_vector3(inManifold.GetWorldSpaceContactPointOn2(0));
-		_listener->on_contact_begin(e1, e2, p1, p2);
+		push_event({
+			.p1	  = to_vector3(inManifold.GetWorldSpaceContactPointOn1(0)),
+			.p2	  = to_vector3(inManifold.GetWorldSpaceContactPointOn2(0)),
+			.e1	  = e1,
+			.e2	  = e2,
+			.type = type,
+		});
 	}
 
-	void physics_world_contact_listener::dispatch_contact(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold)
+	void physics_world_contact_listener::push_event(const physics_contact_event& ev)
 	{
-		if (_listener == nullptr)
-			return;
-
-		world_handle e1 = _world.get_comp_physics_entity_by_id(inBody1.GetID());
-		world_handle e2 = _world.get_comp_physics_entity_by_id(inBody2.GetID());
-		if (e1.is_null() || e2.is_null())
-			return;
-
-		const vector3 p1 = to_vector3(inManifold.GetWorldSpaceContactPointOn1(0));
-		const vector3 p2 = to_vector3(inManifold.GetWorldSpaceContactPointOn2(0));
-		_listener->on_contact(e1, e2, p1, p2);
+		// called from jolt workers, a slot is claimed atomically and overflow is counted but not written.
+		const uint32 slot = _event_count.fetch_add(1, std::memory_order_relaxed);
+		if (slot < MAX_PHYSICS_CONTACT_EVENTS)
+			_events[slot] = ev;
 	}
 }
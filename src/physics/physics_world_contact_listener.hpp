@@ -23,9 +23,12 @@ OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGEN
 OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
 OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-
 #pragma once
 
+#include "world/world_constants.hpp"
+#include "math/vector3.hpp"
+#include "data/atomic.hpp"
+
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Collision/ContactListener.h>
 
@@ -41,15 +44,34 @@ namespace SFG
 {
 	class physics_world;
 	class physics_contact_listener;
-	struct vector3;
+
+	enum class physics_contact_event_type : uint8
+	{
+		begin,
+		persist,
+		end,
+	};
+
+	struct physics_contact_event
+	{
+		vector3					   p1	= vector3::zero;
+		vector3					   p2	= vector3::zero;
+		world_handle			   e1	= {};
+		world_handle			   e2	= {};
+		physics_contact_event_type type = physics_contact_event_type::begin;
+	};
 
 	class physics_world_contact_listener final : public JPH::ContactListener
 	{
 	public:
 		explicit physics_world_contact_listener(physics_world& world);
+		~physics_world_contact_listener();
 
 		void set_listener(physics_contact_listener* listener);
 
+		// dispatches contacts buffered during the last update on the calling thread.
+		void flush();
+
 		void OnContactAdded(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
 		void OnContactPersisted(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, JPH::ContactSettings& ioSettings) override;
 		void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override;
@@ -57,10 +79,12 @@ namespace SFG
 	private:
 		static vector3 to_vector3(const JPH::RVec3& v);
 
-		void dispatch_contact_begin(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold);
-		void dispatch_contact(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold);
+		void push_contact(const JPH::Body& inBody1, const JPH::Body& inBody2, const JPH::ContactManifold& inManifold, physics_contact_event_type type);
+		void push_event(const physics_contact_event& ev);
 
 		physics_world&			  _world;
-		physics_contact_listener* _listener = nullptr;
+		physics_contact_listener* _listener	   = nullptr;
+		physics_contact_event*	  _events	   = nullptr;
+		atomic<uint32>			  _event_count = 0;
 	};
 }
@@ -0,0 +1,115 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "platform/mapped_file.hpp"
+#include "io/log.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+namespace SFG
+{
+	mapped_file::~mapped_file()
+	{
+		close();
+	}
+
+	bool mapped_file::open(const char* path)
+	{
+		close();
+
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			SFG_ERR("[mapped_file] -> Could not open file! {0}", path);
+			return false;
+		}
+
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			SFG_ERR("[mapped_file] -> Could not query file size! {0}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			SFG_ERR("[mapped_file] -> Could not create file mapping! {0}", path);
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			SFG_ERR("[mapped_file] -> Could not map view of file! {0}", path);
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file	 = file;
+		_mapping = mapping;
+		_data	 = static_cast<uint8*>(view);
+		_size	 = static_cast<size_t>(size.QuadPart);
+		return true;
+	}
+
+	void mapped_file::close()
+	{
+		if (_data != nullptr)
+			UnmapViewOfFile(_data);
+		if (_mapping != nullptr)
+			CloseHandle(static_cast<HANDLE>(_mapping));
+		if (_file != nullptr)
+			CloseHandle(static_cast<HANDLE>(_file));
+
+		_file	 = nullptr;
+		_mapping = nullptr;
+		_data	 = nullptr;
+		_size	 = 0;
+	}
+
+	void mapped_file::release_range(size_t offset, size_t size)
+	{
+		if (_data == nullptr || size == 0 || offset >= _size)
+			return;
+
+		// only whole pages inside the range are trimmed, neighbouring entries sharing a page stay resident.
+		SYSTEM_INFO info = {};
+		GetSystemInfo(&info);
+		const size_t page  = static_cast<size_t>(info.dwPageSize);
+		const size_t end   = (offset + size < _size ? offset + size : _size) & ~(page - 1);
+		const size_t begin = (offset + page - 1) & ~(page - 1);
+		if (end <= begin)
+			return;
+
+		// unlocking a range that was never locked drops its pages from the working set, the view stays valid and faults them back in on access.
+		VirtualUnlock(_data + begin, end - begin);
+	}
+}
@@ -81,9 +81,7 @@ namespace SFG
 			{
 				keyframes					  = alloc.allocate<animation_keyframe_v3>(keyframes_count);
 				animation_keyframe_v3* ptr_kf = alloc.get<animation_keyframe_v3>(keyframes);
-
-				for (uint16 i = 0; i < keyframes_count; i++)
-					ptr_kf[i] = raw.keyframes[i];
+				SFG_MEMCPY(ptr_kf, raw.keyframes.data(), sizeof(animation_keyframe_v3) * keyframes_count);
 			}
 		}
 	}
@@ -193,8 +191,7 @@ namespace SFG
 			{
 				keyframes					 = alloc.allocate<animation_keyframe_q>(keyframes_count);
 				animation_keyframe_q* ptr_kf = alloc.get<animation_keyframe_q>(keyframes);
-				for (uint16 i = 0; i < keyframes_count; i++)
-					ptr_kf[i] = raw.keyframes[i];
+				SFG_MEMCPY(ptr_kf, raw.keyframes.data(), sizeof(animation_keyframe_q) * keyframes_count);
 			}
 		}
 	}
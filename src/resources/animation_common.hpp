@@ -29,6 +29,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "common/size_definitions.hpp"
 #include "math/vector3.hpp"
 #include "math/quat.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -51,6 +52,8 @@ namespace SFG
 		void deserialize(istream& stream);
 	};
 
+	SFG_STREAM_LAYOUT_RAW(animation_keyframe_v3, 16);
+
 	struct animation_keyframe_v3_spline
 	{
 		float	time		= 0.0f;
@@ -71,6 +74,8 @@ namespace SFG
 		void deserialize(istream& stream);
 	};
 
+	SFG_STREAM_LAYOUT_RAW(animation_keyframe_q, 20);
+
 	struct animation_keyframe_q_spline
 	{
 		float time		  = 0.0f;
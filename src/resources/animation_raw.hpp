@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "animation_common.hpp"
 #include "data/vector.hpp"
+#include "data/rel_array.hpp"
 #include "data/string.hpp"
 #include "common/string_id.hpp"
 
@@ -39,7 +40,7 @@ namespace SFG
 	struct animation_channel_v3_raw
 	{
 		animation_interpolation				 interpolation = animation_interpolation::linear;
-		vector<animation_keyframe_v3>		 keyframes;
+		rel_array<animation_keyframe_v3>	 keyframes;
 		vector<animation_keyframe_v3_spline> keyframes_spline;
 		int16								 node_index = -1;
 
@@ -50,7 +51,7 @@ namespace SFG
 	struct animation_channel_q_raw
 	{
 		animation_interpolation				interpolation = animation_interpolation::linear;
-		vector<animation_keyframe_q>		keyframes;
+		rel_array<animation_keyframe_q>		keyframes;
 		vector<animation_keyframe_q_spline> keyframes_spline;
 		int16								node_index = -1;
 
@@ -25,8 +25,18 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "resources/common_resources.hpp"
+#include "data/istream.hpp"
 
 namespace SFG
 {
+	bool read_cache_version(istream& stream)
+	{
+		uint32 cache_version = 0;
+		stream >> cache_version;
+		if (cache_version == RESOURCE_CACHE_VERSION)
+			return true;
 
+		stream.destroy();
+		return false;
+	}
 }
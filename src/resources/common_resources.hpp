@@ -35,6 +35,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace SFG
 {
+	class istream;
 
 #define DUMMY_COLOR_TEXTURE_SID	 UINT64_MAX - 1000
 #define DUMMY_NORMAL_TEXTURE_SID UINT64_MAX - 999
@@ -65,6 +66,12 @@ namespace SFG
 #define DEFAULT_GUI_SDF_MAT_PATH "assets/engine/materials/world/gui_sdf.stkmat"
 #define DEFAULT_GUI_SDF_MAT_SID	 "assets/engine/materials/world/gui_sdf.stkmat"_hs
 
+	// leads every editor cache meta file, caches written with another version are rebuilt. bump whenever a raw's serialized layout changes.
+	static constexpr uint32 RESOURCE_CACHE_VERSION = 2;
+
+	// reads the version leading a cache meta stream, a stale stream is destroyed and false returned so the caller rebuilds the cache.
+	bool read_cache_version(istream& stream);
+
 	typedef pool_handle16 resource_handle;
 	typedef uint16		  resource_id;
 
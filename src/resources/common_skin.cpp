@@ -35,6 +35,7 @@ namespace SFG
 		stream << model_node_index;
 		stream << inverse_bind_matrix;
 		stream << name_hash;
+		stream << bounds_radius;
 	}
 
 	void skin_joint::deserialize(istream& stream)
@@ -42,5 +43,6 @@ namespace SFG
 		stream >> model_node_index;
 		stream >> inverse_bind_matrix;
 		stream >> name_hash;
+		stream >> bounds_radius;
 	}
 }
\ No newline at end of file
@@ -43,6 +43,7 @@ namespace SFG
 		matrix4x3 inverse_bind_matrix = {};
 		matrix4x3 local_matrix		  = {};
 		string_id name_hash			  = 0;
+		float	  bounds_radius		  = 0.0f;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
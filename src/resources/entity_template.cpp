@@ -41,10 +41,12 @@ namespace SFG
 	void entity_template::create_from_loader(entity_template_raw& raw, world& w, resource_handle handle)
 	{
 		_raw = raw;
+		_plan.reset();
 	}
 
 	void entity_template::destroy(world& w, resource_handle handle)
 	{
+		_plan.reset();
 		if (_raw.component_buffer.get_size() != 0)
 			_raw.component_buffer.destroy();
 	}
@@ -29,6 +29,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "resources/common_resources.hpp"
 #include "reflection/type_reflection.hpp"
 #include "entity_template_raw.hpp"
+#include "entity_template_plan.hpp"
 
 namespace SFG
 {
@@ -56,8 +57,14 @@ namespace SFG
 			return _raw;
 		}
 
+		inline entity_template_plan& get_plan()
+		{
+			return _plan;
+		}
+
 	private:
-		entity_template_raw _raw = {};
+		entity_template_raw	 _raw  = {};
+		entity_template_plan _plan = {};
 	};
 
 	REFLECT_TYPE(entity_template);
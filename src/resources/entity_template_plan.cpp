@@ -0,0 +1,207 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "entity_template_plan.hpp"
+#include "entity_template_raw.hpp"
+#include "reflection/reflection.hpp"
+#include "entity_template_utils.hpp"
+#include "world/components/comp_physics.hpp"
+#include "data/istream.hpp"
+#include "memory/memory.hpp"
+#include "common/type_id.hpp"
+
+namespace SFG
+{
+	uint32 entity_template_plan::append_data(const void* src, uint32 size)
+	{
+		const uint32 offset = static_cast<uint32>(_data.size());
+		_data.resize(offset + size);
+		SFG_MEMCPY(_data.data() + offset, src, size);
+		return offset;
+	}
+
+	class entity_template_plan::compiler final : public component_record_visitor
+	{
+	public:
+		compiler(entity_template_plan& plan, uint32 entity_count) : _plan(plan), _entity_count(entity_count){};
+
+		meta* begin_component(string_id comp_type, uint32 entity_index) override
+		{
+			SFG_ASSERT(entity_index < _entity_count);
+
+			meta& comp_meta = reflection::get().resolve(comp_type);
+
+			_comp = {
+				.comp_meta	  = &comp_meta,
+				.comp_type	  = comp_type,
+				.entity_index = entity_index,
+				.field_start  = static_cast<uint32>(_plan._fields.size()),
+				.has_load_cb  = comp_meta.has_function("on_reflect_load"_hs),
+				.is_physics	  = comp_type == type_id<comp_physics>::value,
+			};
+			return &comp_meta;
+		}
+
+		void end_component() override
+		{
+			_comp.field_count = static_cast<uint32>(_plan._fields.size()) - _comp.field_start;
+			_plan._physics_count += _comp.is_physics;
+			_plan._comps.push_back(_comp);
+		}
+
+		void on_pod(field_base* target, const void* data, uint32 size) override
+		{
+			if (!target)
+				return;
+
+			_plan._fields.push_back({
+				.target		 = target,
+				.data_offset = _plan.append_data(data, size),
+				.data_size	 = size,
+				.op			 = entity_template_plan_op::pod,
+			});
+		}
+
+		void on_string(field_base* target, const string& val) override
+		{
+			if (!target)
+				return;
+
+			_plan._fields.push_back({
+				.target		 = target,
+				.data_offset = _plan.append_data(val.c_str(), static_cast<uint32>(val.size() + 1)),
+				.data_size	 = static_cast<uint32>(val.size() + 1),
+				.op			 = entity_template_plan_op::string,
+			});
+		}
+
+		void on_resource(field_base* target, string_id sub_type, const string& path, uint32 index, uint32 count) override
+		{
+			if (!target)
+				return;
+
+			// non-list fields keep the last element, same as the regular path.
+			const string_id hash = path.empty() ? 0 : TO_SID(path);
+			if (!target->_is_list && index + 1 != count)
+				return;
+
+			const uint32 offset = _plan.append_data(&hash, sizeof(string_id));
+			if (index == 0 || !target->_is_list)
+				_list_start = offset;
+
+			if (index + 1 != count)
+				return;
+
+			_plan._fields.push_back({
+				.target		 = target,
+				.sub_type	 = sub_type,
+				.data_offset = _list_start,
+				.data_size	 = offset + static_cast<uint32>(sizeof(string_id)) - _list_start,
+				.op			 = target->_is_list ? entity_template_plan_op::resource_list : entity_template_plan_op::resource,
+			});
+		}
+
+		void on_entity(field_base* target, int32 entity_index, size_t stream_offset, uint32 index, uint32 count) override
+		{
+			if (!target)
+				return;
+
+			if (!target->_is_list && index + 1 != count)
+				return;
+
+			const uint32 offset = _plan.append_data(&entity_index, sizeof(int32));
+			if (index == 0 || !target->_is_list)
+				_list_start = offset;
+
+			if (index + 1 != count)
+				return;
+
+			_plan._fields.push_back({
+				.target		 = target,
+				.data_offset = _list_start,
+				.data_size	 = offset + static_cast<uint32>(sizeof(int32)) - _list_start,
+				.op			 = target->_is_list ? entity_template_plan_op::entity_list : entity_template_plan_op::entity,
+			});
+		}
+
+	private:
+		entity_template_plan&	  _plan;
+		entity_template_plan_comp _comp			= {};
+		uint32					  _entity_count = 0;
+		uint32					  _list_start	= 0;
+	};
+
+	bool entity_template_plan::compile(const entity_template_raw& raw)
+	{
+		reset();
+		_is_compiled = 1;
+
+		// nested templates are instantiated recursively, those stay on the regular path.
+		for (const entity_template_entity_raw& r : raw.entities)
+		{
+			if (!r.template_reference.empty())
+				return false;
+		}
+
+		const uint32 entity_count = static_cast<uint32>(raw.entities.size());
+		_entities.resize(entity_count);
+
+		for (uint32 i = 0; i < entity_count; i++)
+		{
+			const entity_template_entity_raw& r = raw.entities[i];
+			entity_template_plan_entity&	  e = _entities[i];
+			e.position							= r.position;
+			e.rotation							= r.rotation;
+			e.scale								= r.scale;
+			e.parent							= r.parent;
+			e.visible							= r.visible;
+			e.name_offset						= append_data(r.name.c_str(), static_cast<uint32>(r.name.size() + 1));
+			e.tag_offset						= append_data(r.tag.c_str(), static_cast<uint32>(r.tag.size() + 1));
+		}
+
+		istream	 in(raw.component_buffer.get_raw(), raw.component_buffer.get_size());
+		compiler c(*this, entity_count);
+		while (entity_template_utils::visit_component_record(in, c))
+		{
+		}
+
+		_is_supported = 1;
+		return true;
+	}
+
+	void entity_template_plan::reset()
+	{
+		_entities.resize(0);
+		_comps.resize(0);
+		_fields.resize(0);
+		_data.resize(0);
+		_physics_count = 0;
+		_is_compiled   = 0;
+		_is_supported  = 0;
+	}
+
+}
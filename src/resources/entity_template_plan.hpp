@@ -0,0 +1,149 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "common/string_id.hpp"
+#include "data/vector.hpp"
+#include "math/vector3.hpp"
+#include "math/quat.hpp"
+
+namespace SFG
+{
+	class meta;
+	class field_base;
+	struct entity_template_raw;
+
+	enum class entity_template_plan_op : uint8
+	{
+		pod,
+		string,
+		resource,
+		resource_list,
+		entity,
+		entity_list,
+	};
+
+	struct entity_template_plan_entity
+	{
+		quat	rotation	= quat::identity;
+		vector3 position	= vector3::zero;
+		vector3 scale		= vector3::one;
+		int32	parent		= -1;
+		uint32	name_offset = 0;
+		uint32	tag_offset	= 0;
+		uint8	visible		= 0;
+	};
+
+	struct entity_template_plan_field
+	{
+		field_base*				target		= nullptr;
+		string_id				sub_type	= 0;
+		uint32					data_offset = 0;
+		uint32					data_size	= 0;
+		entity_template_plan_op op			= entity_template_plan_op::pod;
+	};
+
+	struct entity_template_plan_comp
+	{
+		meta*	  comp_meta	   = nullptr;
+		string_id comp_type	   = 0;
+		uint32	  entity_index = 0;
+		uint32	  field_start  = 0;
+		uint32	  field_count  = 0;
+		uint8	  has_load_cb  = 0;
+		uint8	  is_physics   = 0;
+	};
+
+	/*
+	 * Flattened form of an entity_template_raw, compiled once and stamped out by entity_manager::spawn_template.
+	 * Field lookups and stream parsing are done at compile time, spawning only copies prebuilt values into freshly
+	 * added components. Entity references are kept as template-local indices, resources as path hashes resolved once
+	 * per spawn so a plan stays valid while the resources it names are unloaded or reloaded.
+	 * Templates referencing other templates are not compiled, spawning falls back to instantiate_template.
+	 */
+	class entity_template_plan
+	{
+	public:
+		bool compile(const entity_template_raw& raw);
+		void reset();
+
+		// -----------------------------------------------------------------------------
+		// accessors
+		// -----------------------------------------------------------------------------
+
+		inline bool is_compiled() const
+		{
+			return _is_compiled;
+		}
+
+		inline bool is_supported() const
+		{
+			return _is_supported;
+		}
+
+		inline const vector<entity_template_plan_entity>& get_entities() const
+		{
+			return _entities;
+		}
+
+		inline const vector<entity_template_plan_comp>& get_comps() const
+		{
+			return _comps;
+		}
+
+		inline const vector<entity_template_plan_field>& get_fields() const
+		{
+			return _fields;
+		}
+
+		inline const uint8* get_data() const
+		{
+			return _data.data();
+		}
+
+		inline uint32 get_physics_count() const
+		{
+			return _physics_count;
+		}
+
+	private:
+		class compiler;
+
+		uint32 append_data(const void* src, uint32 size);
+
+	private:
+		vector<entity_template_plan_entity> _entities	   = {};
+		vector<entity_template_plan_comp>	_comps		   = {};
+		vector<entity_template_plan_field>	_fields		   = {};
+		vector<uint8>						_data		   = {};
+		uint32								_physics_count = 0;
+		uint8								_is_compiled   = 0;
+		uint8								_is_supported  = 0;
+	};
+}
@@ -41,6 +41,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "world/component_manager.hpp"
 #include "math/color.hpp"
 #include "serialization/serialization.hpp"
+#include "resources/common_resources.hpp"
 #include <fstream>
 #include <vendor/nhlohmann/json.hpp>
 #include "resources/entity_template_utils.hpp"
@@ -300,6 +301,9 @@ namespace SFG
 
 		istream stream = serialization::load_from_file(meta_cache_path.c_str());
 
+		if (!read_cache_version(stream))
+			return false;
+
 		string file_path				= "";
 		uint64 saved_file_last_modified = 0;
 		stream >> file_path;
@@ -329,6 +333,7 @@ namespace SFG
 		const string data_cache_path = cache_folder_path + relative + "-" + sid_str + "_data" + extension;
 
 		ostream out_stream;
+		out_stream << RESOURCE_CACHE_VERSION;
 		out_stream << file_path;
 		out_stream << file_last_modified;
 		serialization::save_to_file(meta_cache_path.c_str(), out_stream);
@@ -392,158 +392,215 @@ namespace SFG
 	}
 #endif // SFG_TOOLMODE
 
-	void entity_template_utils::fill_components_from_buffer(istream& in, const static_vector<world_handle, 1024>& created, component_manager& cm, resource_manager& rm, world& w)
+	namespace
+	{
+		template <typename T> void visit_pod(istream& in, field_base* target, component_record_visitor& visitor)
+		{
+			T val = {};
+			in >> val;
+			visitor.on_pod(target, &val, static_cast<uint32>(sizeof(T)));
+		}
+
+#ifdef SFG_TOOLMODE
+		class record_scanner final : public component_record_visitor
+		{
+		public:
+			record_scanner(component_record& rec) : _rec(rec){};
+
+			meta* begin_component(string_id comp_type, uint32 entity_index) override
+			{
+				_rec.comp_type = comp_type;
+				_rec.entity	   = entity_index;
+				return nullptr;
+			}
+
+			void on_resource(field_base* target, string_id sub_type, const string& path, uint32 index, uint32 count) override
+			{
+				if (!path.empty())
+					_rec.resources.push_back(path);
+			}
+
+			void on_entity(field_base* target, int32 entity_index, size_t stream_offset, uint32 index, uint32 count) override
+			{
+				// offset within the record, callers copy the record and patch indices in place.
+				_rec.entity_ref_offsets.push_back(stream_offset - _rec.begin);
+			}
+
+		private:
+			component_record& _rec;
+		};
+#endif
+
+		class component_filler final : public component_record_visitor
+		{
+		public:
+			component_filler(const static_vector<world_handle, 1024>& created, component_manager& cm, resource_manager& rm, world& w) : _created(created), _cm(cm), _rm(rm), _world(w){};
+
+			meta* begin_component(string_id comp_type, uint32 entity_index) override
+			{
+				const world_handle comp_handle = _cm.add_component(comp_type, _created[entity_index]);
+				_comp_ptr					   = _cm.get_component(comp_type, comp_handle);
+				_comp_meta					   = &reflection::get().resolve(comp_type);
+				return _comp_meta;
+			}
+
+			void end_component() override
+			{
+				if (_comp_meta->has_function("on_reflect_load"_hs))
+					_comp_meta->invoke_function<void, void*, world&>("on_reflect_load"_hs, _comp_ptr, _world);
+			}
+
+			void on_pod(field_base* target, const void* data, uint32 size) override
+			{
+				if (target)
+					SFG_MEMCPY(target->value(_comp_ptr).cast_ptr<uint8>(), data, size);
+			}
+
+			void on_string(field_base* target, const string& val) override
+			{
+				if (target)
+					target->value(_comp_ptr).cast_ref<string>() = val;
+			}
+
+			void on_resource(field_base* target, string_id sub_type, const string& path, uint32 index, uint32 count) override
+			{
+				if (!target)
+					return;
+
+				const resource_handle h = path.empty() ? resource_handle() : _rm.get_resource_handle_by_hash_if_exists(sub_type, TO_SID(path));
+				if (target->_is_list)
+					target->value(_comp_ptr).cast_ref<vector<resource_handle>>().push_back(h);
+				else
+					target->value(_comp_ptr).cast_ref<resource_handle>() = h;
+			}
+
+			void on_entity(field_base* target, int32 entity_index, size_t stream_offset, uint32 index, uint32 count) override
+			{
+				if (!target)
+					return;
+
+				const world_handle h = entity_index == -1 ? world_handle() : _created[entity_index];
+				if (target->_is_list)
+					target->value(_comp_ptr).cast_ref<vector<world_handle>>().push_back(h);
+				else
+					target->value(_comp_ptr).cast_ref<world_handle>() = h;
+			}
+
+		private:
+			const static_vector<world_handle, 1024>& _created;
+			component_manager&						 _cm;
+			resource_manager&						 _rm;
+			world&									 _world;
+			meta*									 _comp_meta = nullptr;
+			void*									 _comp_ptr	= nullptr;
+		};
+	}
+
+	bool entity_template_utils::visit_component_record(istream& in, component_record_visitor& visitor)
 	{
-		while (!in.is_eof())
+		string_id comp_type = 0;
+		uint32	  e_index	= 0;
+		uint32	  fields_sz = 0;
+		in >> comp_type;
+		if (in.is_eof())
+			return false;
+		in >> e_index;
+		in >> fields_sz;
+
+		meta*				   comp_meta  = visitor.begin_component(comp_type, e_index);
+		const meta::field_vec* ref_fields = comp_meta ? &comp_meta->get_fields() : nullptr;
+
+		for (uint32 j = 0; j < fields_sz; ++j)
 		{
-			string_id comp_type = 0;
-			uint32	  e_index	= 0;
-			uint32	  fields_sz = 0;
-			in >> comp_type;
-			if (in.is_eof())
-				break;
-			in >> e_index;
-			in >> fields_sz;
-
-			const world_handle entity_handle = created[e_index];
-			const world_handle comp_handle	 = cm.add_component(comp_type, entity_handle);
-			void*			   comp_ptr		 = cm.get_component(comp_type, comp_handle);
-
-			meta&		comp_meta  = reflection::get().resolve(comp_type);
-			const auto& ref_fields = comp_meta.get_fields();
-
-			for (uint32 j = 0; j < fields_sz; ++j)
+			string_id			 title_sid = 0;
+			reflected_field_type ft		   = reflected_field_type::rf_float;
+			in >> title_sid;
+			in >> ft;
+
+			field_base* target_field = nullptr;
+			if (ref_fields)
 			{
-				string_id			 title_sid = 0;
-				reflected_field_type ft		   = reflected_field_type::rf_float;
-				in >> title_sid;
-				in >> ft;
-
-				field_base* target_field = nullptr;
-				auto		it			 = std::find_if(ref_fields.begin(), ref_fields.end(), [title_sid](field_base* fb) { return fb->_sid == title_sid; });
-				if (it != ref_fields.end())
+				auto it = std::find_if(ref_fields->begin(), ref_fields->end(), [title_sid](field_base* fb) { return fb->_sid == title_sid; });
+				if (it != ref_fields->end())
 					target_field = *it;
+			}
 
-				if (ft == reflected_field_type::rf_float)
-				{
-					float val = 0.0f;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<float>() = val;
-				}
-				else if (ft == reflected_field_type::rf_int)
-				{
-					int32 val = 0;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<int32>() = val;
-				}
-				else if (ft == reflected_field_type::rf_uint)
-				{
-					uint32 val = 0;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<uint32>() = val;
-				}
-				else if (ft == reflected_field_type::rf_vector2)
-				{
-					vector2 val = vector2::zero;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<vector2>() = val;
-				}
-				else if (ft == reflected_field_type::rf_vector2ui16)
-				{
-					vector2ui16 val;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<vector2ui16>() = val;
-				}
-				else if (ft == reflected_field_type::rf_vector3)
-				{
-					vector3 val = vector3::zero;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<vector3>() = val;
-				}
-				else if (ft == reflected_field_type::rf_vector4)
-				{
-					vector4 val = vector4::zero;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<vector4>() = val;
-				}
-				else if (ft == reflected_field_type::rf_color)
-				{
-					color val = color::white;
-					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<color>() = val;
-				}
-				else if (ft == reflected_field_type::rf_string)
+			if (ft == reflected_field_type::rf_float)
+				visit_pod<float>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_int)
+				visit_pod<int32>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_uint)
+				visit_pod<uint32>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_vector2)
+				visit_pod<vector2>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_vector2ui16)
+				visit_pod<vector2ui16>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_vector3)
+				visit_pod<vector3>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_vector4)
+				visit_pod<vector4>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_color)
+				visit_pod<color>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_uint8 || ft == reflected_field_type::rf_bool || ft == reflected_field_type::rf_enum)
+				visit_pod<uint8>(in, target_field, visitor);
+			else if (ft == reflected_field_type::rf_string)
+			{
+				string val = "";
+				in >> val;
+				visitor.on_string(target_field, val);
+			}
+			else if (ft == reflected_field_type::rf_resource)
+			{
+				string_id sub_type = 0;
+				uint32	  count	   = 0;
+				in >> sub_type;
+				in >> count;
+				for (uint32 i = 0; i < count; ++i)
 				{
 					string val = "";
 					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<string>() = val;
+					visitor.on_resource(target_field, sub_type, val, i, count);
 				}
-				else if (ft == reflected_field_type::rf_uint8 || ft == reflected_field_type::rf_bool || ft == reflected_field_type::rf_enum)
+			}
+			else if (ft == reflected_field_type::rf_entity)
+			{
+				uint32 count = 0;
+				in >> count;
+				for (uint32 i = 0; i < count; ++i)
 				{
-					uint8 val = 0;
+					const size_t offset = in.tellg();
+					int32		 val	= -1;
 					in >> val;
-					if (target_field)
-						target_field->value(comp_ptr).cast_ref<uint8>() = val;
+					visitor.on_entity(target_field, val, offset, i, count);
 				}
-				else if (ft == reflected_field_type::rf_resource)
-				{
-					string_id sub_type = 0;
-					uint32	  count	   = 0;
-					in >> sub_type;
-					in >> count;
-					for (uint32 i = 0; i < count; ++i)
-					{
-						string val = "";
-						in >> val;
-						if (!target_field)
-							continue;
+			}
+		}
 
-						if (target_field->_is_list)
-						{
-							auto& v = target_field->value(comp_ptr).cast_ref<vector<resource_handle>>();
-							v.push_back(val.empty() ? resource_handle() : rm.get_resource_handle_by_hash_if_exists(sub_type, TO_SID(val)));
-						}
-						else
-						{
-							target_field->value(comp_ptr).cast_ref<resource_handle>() = val.empty() ? resource_handle() : rm.get_resource_handle_by_hash_if_exists(sub_type, TO_SID(val));
-						}
-					}
-				}
-				else if (ft == reflected_field_type::rf_entity)
-				{
-					uint32 count = 0;
-					in >> count;
-					for (uint32 i = 0; i < count; ++i)
-					{
-						int32 val = -1;
-						in >> val;
-						if (!target_field)
-							continue;
+		visitor.end_component();
+		return true;
+	}
 
-						if (target_field->_is_list)
-						{
-							auto& v = target_field->value(comp_ptr).cast_ref<vector<world_handle>>();
-							v.push_back(val == -1 ? world_handle() : created[val]);
-						}
-						else
-						{
-							target_field->value(comp_ptr).cast_ref<world_handle>() = (val == -1 ? world_handle() : created[val]);
-						}
-					}
-				}
-			}
+#ifdef SFG_TOOLMODE
+	bool entity_template_utils::scan_component_record(istream& in, component_record& out)
+	{
+		out.entity_ref_offsets.resize(0);
+		out.resources.resize(0);
+		out.begin = in.tellg();
+
+		record_scanner scanner(out);
+		if (!visit_component_record(in, scanner))
+			return false;
+
+		out.end = in.tellg();
+		return true;
+	}
+#endif
 
-			if (comp_meta.has_function("on_reflect_load"_hs))
-				comp_meta.invoke_function<void, void*, world&>("on_reflect_load"_hs, comp_ptr, w);
+	void entity_template_utils::fill_components_from_buffer(istream& in, const static_vector<world_handle, 1024>& created, component_manager& cm, resource_manager& rm, world& w)
+	{
+		component_filler filler(created, cm, rm, w);
+		while (visit_component_record(in, filler))
+		{
 		}
 	}
 }
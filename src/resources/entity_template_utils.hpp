@@ -46,11 +46,44 @@ namespace SFG
 	class entity_manager;
 	class component_manager;
 	class resource_manager;
+	class meta;
+	class field_base;
 	struct entity_template_entity_raw;
 
+	/*
+	 * Receives the decoded values of serialized component records, see entity_template_utils::visit_component_record.
+	 * target is the reflected field a value belongs to, null if the field no longer exists or begin_component returned no meta.
+	 * Resource and entity fields arrive one element at a time along with their position in the list.
+	 */
+	class component_record_visitor
+	{
+	public:
+		virtual ~component_record_visitor() = default;
+
+		virtual meta* begin_component(string_id comp_type, uint32 entity_index) = 0;
+		virtual void  end_component() {};
+		virtual void  on_pod(field_base* target, const void* data, uint32 size) {};
+		virtual void  on_string(field_base* target, const string& val) {};
+		virtual void  on_resource(field_base* target, string_id sub_type, const string& path, uint32 index, uint32 count) {};
+		virtual void  on_entity(field_base* target, int32 entity_index, size_t stream_offset, uint32 index, uint32 count) {};
+	};
+
+#ifdef SFG_TOOLMODE
+	struct component_record
+	{
+		size_t		   begin			  = 0;
+		size_t		   end				  = 0;
+		string_id	   comp_type		  = 0;
+		uint32		   entity			  = 0;
+		vector<size_t> entity_ref_offsets = {};
+		vector<string> resources		  = {};
+	};
+#endif
+
 	struct entity_template_utils
 	{
 #ifdef SFG_TOOLMODE
+		static bool scan_component_record(istream& in, component_record& out_record);
 		static void append_entity_components_as_json(
 			nlohmann::json& out_components_array, world_handle entity, uint32 entity_index, entity_manager& em, component_manager& cm, resource_manager& rm, const hash_map<uint32, int32>& index_by_world, vector<string>& out_resource_paths);
 		static void						  component_json_to_component_buffer(const nlohmann::json& comp_json, ostream& out_buffer);
@@ -58,6 +91,7 @@ namespace SFG
 		static entity_template_entity_raw entity_to_entity_template_entity_raw(world_handle entity, entity_manager& em, resource_manager& rm, const hash_map<uint32, int32>& index_by_world);
 #endif
 
+		static bool visit_component_record(istream& in, component_record_visitor& visitor);
 		static void fill_components_from_buffer(istream& in, const static_vector<world_handle, 1024>& created, component_manager& cm, resource_manager& rm, world& w);
 	};
 }
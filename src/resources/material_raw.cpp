@@ -35,6 +35,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "io/log.hpp"
 #include "io/file_system.hpp"
 #include "serialization/serialization.hpp"
+#include "resources/common_resources.hpp"
 #include <fstream>
 using json = nlohmann::json;
 #endif
@@ -219,6 +220,9 @@ namespace SFG
 
 		istream stream = serialization::load_from_file(meta_cache_path.c_str());
 
+		if (!read_cache_version(stream))
+			return false;
+
 		string file_path				= "";
 		uint64 saved_file_last_modified = 0;
 		stream >> file_path;
@@ -248,6 +252,7 @@ namespace SFG
 		const string data_cache_path = cache_folder_path + relative + "-" + sid_str + "_data" + extension;
 
 		ostream out_stream;
+		out_stream << RESOURCE_CACHE_VERSION;
 		out_stream << file_path;
 		out_stream << file_last_modified;
 		serialization::save_to_file(meta_cache_path.c_str(), out_stream);
@@ -33,6 +33,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gfx/event_stream/render_event_stream.hpp"
 #include "gfx/event_stream/render_events_gfx.hpp"
 #include "reflection/reflection.hpp"
+#include "physics/physics_stream.hpp"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
@@ -93,32 +94,43 @@ namespace SFG
 			_collider_vertex_count = static_cast<uint32>(raw.collider_vertices.size());
 			_collider_index_count  = static_cast<uint32>(raw.collider_indices.size());
 
+			// cooked arrays may still point into the package entry, one copy into the resource's own memory.
 			_collider_vertices = alloc.allocate<vector3>(_collider_vertex_count);
 			vector3* vtx	   = alloc.get<vector3>(_collider_vertices);
-			for (uint32 i = 0; i < _collider_vertex_count; i++)
-				vtx[i] = raw.collider_vertices[i];
+			SFG_MEMCPY(vtx, raw.collider_vertices.data(), sizeof(vector3) * _collider_vertex_count);
 
 			_collider_indices	 = alloc.allocate<primitive_index>(_collider_index_count);
 			primitive_index* idx = alloc.get<primitive_index>(_collider_indices);
-			for (uint32 i = 0; i < _collider_index_count; i++)
-				idx[i] = raw.collider_indices[i];
-
-			JPH::VertexList vertices;
-			vertices.reserve(_collider_vertex_count);
-			for (uint32 i = 0; i < _collider_vertex_count; i++)
-				vertices.push_back(JPH::Float3(vtx[i].x, vtx[i].y, vtx[i].z));
-
-			JPH::IndexedTriangleList triangles;
-			const uint32			 tri_count = _collider_index_count / 3;
-			triangles.reserve(tri_count);
-			for (uint32 i = 0; i < tri_count; i++)
+			SFG_MEMCPY(idx, raw.collider_indices.data(), sizeof(primitive_index) * _collider_index_count);
+
+			JPH::ShapeSettings::ShapeResult result;
+
+			if (!raw.collider_shape.empty())
+			{
+				// cooked shape, restores the bvh as built at import.
+				physics_stream_in in(raw.collider_shape.data(), raw.collider_shape.size());
+				result = JPH::Shape::sRestoreFromBinaryState(in);
+			}
+			else
 			{
-				const uint32 base = i * 3;
-				triangles.push_back(JPH::IndexedTriangle(idx[base], idx[base + 1], idx[base + 2]));
+				JPH::VertexList vertices;
+				vertices.reserve(_collider_vertex_count);
+				for (uint32 i = 0; i < _collider_vertex_count; i++)
+					vertices.push_back(JPH::Float3(vtx[i].x, vtx[i].y, vtx[i].z));
+
+				JPH::IndexedTriangleList triangles;
+				const uint32			 tri_count = _collider_index_count / 3;
+				triangles.reserve(tri_count);
+				for (uint32 i = 0; i < tri_count; i++)
+				{
+					const uint32 base = i * 3;
+					triangles.push_back(JPH::IndexedTriangle(idx[base], idx[base + 1], idx[base + 2]));
+				}
+
+				JPH::MeshShapeSettings settings(vertices, triangles);
+				result = settings.Create();
 			}
 
-			JPH::MeshShapeSettings			settings(vertices, triangles);
-			JPH::ShapeSettings::ShapeResult result = settings.Create();
 			if (!result.HasError())
 			{
 				JPH::Shape* shape = result.Get().GetPtr();
@@ -32,6 +32,11 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "data/ostream_vector.hpp"
 #include "data/istream_vector.hpp"
 
+#ifdef SFG_TOOLMODE
+#include "physics/physics_stream.hpp"
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#endif
+
 namespace SFG
 {
 
@@ -47,6 +52,7 @@ namespace SFG
 		stream << materials;
 		stream << collider_vertices;
 		stream << collider_indices;
+		stream << collider_shape;
 	}
 
 	void mesh_raw::deserialize(istream& stream)
@@ -61,6 +67,47 @@ namespace SFG
 		stream >> materials;
 		stream >> collider_vertices;
 		stream >> collider_indices;
+		stream >> collider_shape;
 	}
 
+#ifdef SFG_TOOLMODE
+
+	void mesh_raw::cook_collider_shape()
+	{
+		collider_shape.clear();
+
+		if (collider_vertices.empty() || collider_indices.empty())
+			return;
+
+		JPH::VertexList vertices;
+		vertices.reserve(collider_vertices.size());
+		for (const vector3& v : collider_vertices)
+			vertices.push_back(JPH::Float3(v.x, v.y, v.z));
+
+		JPH::IndexedTriangleList triangles;
+		const uint32			 tri_count = static_cast<uint32>(collider_indices.size() / 3);
+		triangles.reserve(tri_count);
+		for (uint32 i = 0; i < tri_count; i++)
+		{
+			const uint32 base = i * 3;
+			triangles.push_back(JPH::IndexedTriangle(collider_indices[base], collider_indices[base + 1], collider_indices[base + 2]));
+		}
+
+		JPH::MeshShapeSettings			settings(vertices, triangles);
+		JPH::ShapeSettings::ShapeResult result = settings.Create();
+		if (result.HasError())
+		{
+			SFG_ERR("failed cooking collider shape for mesh {0}: {1}", name, result.GetError().c_str());
+			return;
+		}
+
+		// mesh shapes carry no sub shapes and use the default material, binary state alone restores them.
+		vector<uint8>	   shape = {};
+		physics_stream_out out(shape);
+		result.Get()->SaveBinaryState(out);
+		collider_shape = std::move(shape);
+	}
+
+#endif
+
 }
@@ -48,13 +48,16 @@ namespace SFG
 		vector<primitive_static_raw>  primitives_static;
 		vector<primitive_skinned_raw> primitives_skinned;
 		vector<int16>				  materials;
-		vector<vector3>				  collider_vertices;
-		vector<primitive_index>		  collider_indices;
+		rel_array<vector3>			  collider_vertices;
+		rel_array<primitive_index>	  collider_indices;
+		rel_array<uint8>			  collider_shape;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 
 #ifdef SFG_TOOLMODE
+		void cook_collider_shape();
+
 		void save_to_cache(const char* cache_folder_path, const char* resource_directory_path, const char* extension) const
 		{
 		}
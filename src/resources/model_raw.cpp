@@ -34,6 +34,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "io/log.hpp"
 #include "io/file_system.hpp"
 #include "serialization/serialization.hpp"
+#include "resources/common_resources.hpp"
 #include "data/vector_util.hpp"
 #include "math/math.hpp"
 #include "gfx/common/format.hpp"
@@ -279,7 +280,7 @@ namespace SFG
 			*/
 		};
 
-		template <typename VertexType> void append_collider_primitive(vector<vector3>& vertices, vector<primitive_index>& indices, const vector<VertexType>& src_vertices, const vector<primitive_index>& src_indices)
+		template <typename VertexType> void append_collider_primitive(rel_array<vector3>& vertices, rel_array<primitive_index>& indices, const rel_array<VertexType>& src_vertices, const rel_array<primitive_index>& src_indices)
 		{
 			const uint32 base = static_cast<uint32>(vertices.size());
 			for (const auto& v : src_vertices)
@@ -311,6 +312,31 @@ namespace SFG
 			for (const auto& prim : mesh.primitives_skinned)
 				append_collider_primitive(mesh.collider_vertices, mesh.collider_indices, prim.vertices, prim.indices);
 		}
+
+		// grows each joint's radius to enclose every vertex it influences, measured in joint space at bind pose.
+		void build_joint_bounds(skin_raw& skin, const mesh_raw& mesh)
+		{
+			const int32 joints_count = static_cast<int32>(skin.joints.size());
+
+			for (const primitive_skinned_raw& prim : mesh.primitives_skinned)
+			{
+				for (const vertex_skinned& v : prim.vertices)
+				{
+					const int32 indices[4] = {v.bone_indices.x, v.bone_indices.y, v.bone_indices.z, v.bone_indices.w};
+					const float weights[4] = {v.bone_weights.x, v.bone_weights.y, v.bone_weights.z, v.bone_weights.w};
+
+					for (uint8 k = 0; k < 4; k++)
+					{
+						if (weights[k] <= 0.0f || indices[k] < 0 || indices[k] >= joints_count)
+							continue;
+
+						skin_joint&	  joint		= skin.joints[indices[k]];
+						const vector3 joint_pos = joint.inverse_bind_matrix * v.pos;
+						joint.bounds_radius		= math::max(joint.bounds_radius, joint_pos.magnitude());
+					}
+				}
+			}
+		}
 	}
 
 	bool model_raw::import_gtlf(const char* file, const char* relative_path, bool create_materials, bool import_textures)
@@ -347,6 +373,23 @@ namespace SFG
 			return false;
 		}
 
+		// uris are relative to the source file, which is itself relative to the base directory.
+		const size_t source_slash = source.find_last_of('/');
+		const string source_dir	  = source_slash == string::npos ? "" : source.substr(0, source_slash + 1);
+		auto		 add_external = [&](const string& uri) {
+			if (uri.empty() || uri.compare(0, 5, "data:") == 0)
+				return;
+			const string dep = source_dir + uri;
+			if (std::find(source_dependencies.begin(), source_dependencies.end(), dep) == source_dependencies.end())
+				source_dependencies.push_back(dep);
+		};
+
+		source_dependencies.resize(0);
+		for (const tinygltf::Buffer& b : model.buffers)
+			add_external(b.uri);
+		for (const tinygltf::Image& img : model.images)
+			add_external(img.uri);
+
 		const size_t all_meshes_sz = model.meshes.size();
 		loaded_meshes.resize(all_meshes_sz);
 
@@ -564,6 +607,13 @@ namespace SFG
 			}
 		}
 
+		for (const mesh_raw& mesh : loaded_meshes)
+		{
+			if (mesh.skin_index < 0 || mesh.skin_index >= static_cast<int16>(loaded_skins.size()))
+				continue;
+			build_joint_bounds(loaded_skins[mesh.skin_index], mesh);
+		}
+
 		vector<int32>		 loaded_indices;
 		vector<int32>		 loaded_sampler_indices;
 		vector<sampler_desc> samplers;
@@ -1119,7 +1169,10 @@ namespace SFG
 			if (generate_colliders != 0)
 			{
 				for (mesh_raw& mesh : loaded_meshes)
+				{
 					build_mesh_colliders(mesh);
+					mesh.cook_collider_shape();
+				}
 			}
 		}
 		catch (std::exception e)
@@ -1146,26 +1199,43 @@ namespace SFG
 
 		istream stream = serialization::load_from_file(meta_cache_path.c_str());
 
-		string file_path				  = "";
-		string source_path				  = "";
-		uint64 saved_file_last_modified	  = 0;
-		uint64 saved_source_last_modified = 0;
-		uint32 loaded_textures_size		  = 0;
+		if (!read_cache_version(stream))
+			return false;
+
+		string		   file_path						= "";
+		string		   source_path						= "";
+		uint64		   saved_file_last_modified			= 0;
+		uint64		   saved_source_last_modified		= 0;
+		uint32		   loaded_textures_size				= 0;
+		vector<string> saved_dependencies				= {};
+		vector<uint64> saved_dependencies_last_modified = {};
 		stream >> file_path;
 		stream >> source_path;
 		stream >> saved_file_last_modified;
 		stream >> saved_source_last_modified;
+		stream >> saved_dependencies;
+		stream >> saved_dependencies_last_modified;
 		stream.destroy();
 
 		const uint64 file_last_modified = file_system::get_last_modified_ticks(file_path);
 		const uint64 src_last_modified	= file_system::get_last_modified_ticks(source_path);
 
-		if (file_last_modified != saved_file_last_modified || src_last_modified != saved_source_last_modified)
+		if (file_last_modified != saved_file_last_modified || src_last_modified != saved_source_last_modified || saved_dependencies.size() != saved_dependencies_last_modified.size())
 			return false;
 
+		// re-exported buffers or edited textures invalidate the cache just like the source does.
+		const string base = file_path.substr(0, file_path.size() - string(relative_path).size());
+		for (size_t i = 0; i < saved_dependencies.size(); i++)
+		{
+			const string dep = base + saved_dependencies[i];
+			if (file_system::get_last_modified_ticks(dep) != saved_dependencies_last_modified[i])
+				return false;
+		}
+
 		stream = serialization::load_from_file(data_cache_path.c_str());
 		deserialize(stream);
 		stream.destroy();
+		source_dependencies = std::move(saved_dependencies);
 
 		return true;
 	}
@@ -1182,11 +1252,19 @@ namespace SFG
 		const string meta_cache_path = cache_folder_path + relative + "-" + sid_str + "_meta" + extension;
 		const string data_cache_path = cache_folder_path + relative + "-" + sid_str + "_data" + extension;
 
+		vector<uint64> dependencies_last_modified;
+		dependencies_last_modified.reserve(source_dependencies.size());
+		for (const string& dep : source_dependencies)
+			dependencies_last_modified.push_back(file_system::get_last_modified_ticks(resource_directory_path + dep));
+
 		ostream out_stream;
+		out_stream << RESOURCE_CACHE_VERSION;
 		out_stream << file_path;
 		out_stream << source_path;
 		out_stream << file_last_modified;
 		out_stream << src_last_modified;
+		out_stream << source_dependencies;
+		out_stream << dependencies_last_modified;
 		serialization::save_to_file(meta_cache_path.c_str(), out_stream);
 
 		out_stream.shrink(0);
@@ -1199,6 +1277,7 @@ namespace SFG
 	void model_raw::get_dependencies(vector<string>& out_deps) const
 	{
 		out_deps.push_back(source);
+		out_deps.insert(out_deps.end(), source_dependencies.begin(), source_dependencies.end());
 	}
 #endif
 }
@@ -59,6 +59,11 @@ namespace SFG
 
 		aabb total_aabb;
 
+#ifdef SFG_TOOLMODE
+		// external buffers and images the source references, relative to the base directory. only used for cache invalidation, never cooked.
+		vector<string> source_dependencies = {};
+#endif
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 
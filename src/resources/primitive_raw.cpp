@@ -25,8 +25,6 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "primitive_raw.hpp"
-#include "data/ostream_vector.hpp"
-#include "data/istream_vector.hpp"
 
 namespace SFG
 {
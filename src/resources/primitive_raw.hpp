@@ -27,7 +27,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "common/size_definitions.hpp"
-#include "data/vector.hpp"
+#include "data/rel_array.hpp"
 #include "gfx/common/gfx_constants.hpp"
 #include "vertex.hpp"
 #include "math/aabb.hpp"
@@ -41,8 +41,8 @@ namespace SFG
 	{
 		uint16 material_index = 0;
 
-		vector<vertex_static>	vertices;
-		vector<primitive_index> indices;
+		rel_array<vertex_static>   vertices;
+		rel_array<primitive_index> indices;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
@@ -50,9 +50,9 @@ namespace SFG
 
 	struct primitive_skinned_raw
 	{
-		uint16					material_index = 0;
-		vector<vertex_skinned>	vertices;
-		vector<primitive_index> indices;
+		uint16					   material_index = 0;
+		rel_array<vertex_skinned>  vertices;
+		rel_array<primitive_index> indices;
 
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
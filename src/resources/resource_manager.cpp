@@ -63,8 +63,38 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <algorithm>
 #include <execution>
 #include <future>
+#include <numeric>
+#include <tracy/Tracy.hpp>
 namespace SFG
 {
+	namespace
+	{
+		inline uint32 quantize_lod(float v)
+		{
+			// 1/1024 steps, descriptors equal under sampler_desc::operator== land on the same key bar the rare bucket edge.
+			const float q	 = std::round(v * 1024.0f) + 0.0f;
+			uint32		bits = 0;
+			SFG_MEMCPY(&bits, &q, sizeof(float));
+			return bits;
+		}
+
+		uint64 sampler_key(const sampler_desc& desc)
+		{
+			const uint32 fields[9] = {
+				desc.anisotropy,
+				quantize_lod(desc.min_lod),
+				quantize_lod(desc.max_lod),
+				quantize_lod(desc.lod_bias),
+				static_cast<uint32>(desc.flags.value()),
+				static_cast<uint32>(desc.address_u),
+				static_cast<uint32>(desc.address_v),
+				static_cast<uint32>(desc.address_w),
+				static_cast<uint32>(desc.compare),
+			};
+
+			return hash_bytes(reinterpret_cast<const char*>(fields), sizeof(fields));
+		}
+	}
 
 	resource_manager::resource_manager(world& w) : _world(w)
 	{
@@ -225,137 +255,228 @@ namespace SFG
 
 	resource_handle resource_manager::get_or_add_sampler(const sampler_desc& desc)
 	{
-		const cache_storage& storage = get_storage(type_id<texture_sampler>::value);
-
-		auto& sampler_pool = underlying_pool<resource_cache<texture_sampler, texture_sampler_raw, MAX_WORLD_SAMPLERS>, texture_sampler>();
-
-		resource_handle out_handle = {};
-
-		auto it = sampler_pool.handles_begin();
-		for (auto it = sampler_pool.handles_begin(); it != sampler_pool.handles_end(); ++it)
+		auto it = _samplers_by_desc.find(sampler_key(desc));
+		if (it != _samplers_by_desc.end())
 		{
-			const resource_handle  h   = *it;
-			const texture_sampler& smp = get_resource<texture_sampler>(h);
-			if (smp.get_desc() == desc)
+			for (resource_handle h : it->second)
 			{
-				out_handle = h;
-				break;
+				if (is_valid<texture_sampler>(h) && get_resource<texture_sampler>(h).get_desc() == desc)
+					return h;
 			}
 		}
-		if (out_handle.is_null())
-		{
-			out_handle			 = add_resource<texture_sampler>(_dynamic_sampler_count++);
-			texture_sampler& smp = get_resource<texture_sampler>(out_handle);
 
-			texture_sampler_raw raw = {};
-			raw.desc				= desc;
-			smp.create_from_loader(raw, _world, out_handle);
-		}
+		const resource_handle out_handle = add_resource<texture_sampler>(_dynamic_sampler_count++);
+		texture_sampler&	  smp		 = get_resource<texture_sampler>(out_handle);
 
+		// registers itself by descriptor on creation.
+		texture_sampler_raw raw = {};
+		raw.desc				= desc;
+		smp.create_from_loader(raw, _world, out_handle);
 		return out_handle;
 	}
 
-	void resource_manager::load_resources(const vector<string>& relative_paths, package& pkg)
+	void resource_manager::register_sampler(const sampler_desc& desc, resource_handle handle)
 	{
-		vector<string> filtered_relative_paths = {};
-		filtered_relative_paths.reserve(relative_paths.size());
+		_samplers_by_desc[sampler_key(desc)].push_back(handle);
+	}
 
-		for (const string& p : relative_paths)
-		{
-			if (p.empty())
-				continue;
+	void resource_manager::unregister_sampler(const sampler_desc& desc, resource_handle handle)
+	{
+		auto it = _samplers_by_desc.find(sampler_key(desc));
+		if (it == _samplers_by_desc.end())
+			return;
 
-			auto it = std::find_if(filtered_relative_paths.begin(), filtered_relative_paths.end(), [&](const string& str) -> bool { return str.compare(p) == 0; });
-			if (it == filtered_relative_paths.end())
-				filtered_relative_paths.push_back(p);
-		}
+		// order is kept so the oldest live sampler stays the one lookups return.
+		vector<resource_handle>& handles = it->second;
+		auto					 found	 = std::find(handles.begin(), handles.end(), handle);
+		if (found != handles.end())
+			handles.erase(found);
 
-		const uint32 size = static_cast<uint32>(filtered_relative_paths.size());
+		if (handles.empty())
+			_samplers_by_desc.erase(it);
+	}
 
-		vector<void*>	  resolved_loaders(filtered_relative_paths.size());
-		vector<string_id> resolved_types(filtered_relative_paths.size());
+	void resource_manager::load_resources(const vector<string>& relative_paths, package& pkg)
+	{
+		ZoneScoped;
 
-		vector<int> indices(filtered_relative_paths.size());
-		std::iota(indices.begin(), indices.end(), 0);
+		vector<string>				 paths;
+		hash_map<string_id, uint32>	 index_by_sid;
+		hash_map<string_id, uint32>	 index_by_blob;
+		vector<pair<uint32, string>> aliases;
 
-		for (uint32 i = 0; i < filtered_relative_paths.size(); i++)
-		{
-			const string&	path = filtered_relative_paths.at(i);
-			const string_id sid	 = TO_SID(path);
-			const size_t	dot	 = path.find_last_of(".");
-			if (dot == string::npos)
-			{
-				SFG_ERR("could not deduce extension: {0}", path);
-				continue;
-			}
+		auto add_path = [&](const string& p) -> int32 {
+			if (p.empty())
+				return -1;
 
-			const string ext = path.substr(dot + 1, path.size() - dot - 1);
-			const meta*	 m	 = reflection::get().find_by_tag(ext.c_str());
-			if (m == nullptr)
+			const string_id sid = TO_SID(p);
+			auto			it	= index_by_sid.find(sid);
+			if (it != index_by_sid.end())
+				return static_cast<int32>(it->second);
+
+			// paths whose entries share a package blob are decoded and created once, the rest alias that resource.
+			const string_id blob   = pkg.get_canonical(sid);
+			auto			shared = index_by_blob.find(blob);
+			if (shared != index_by_blob.end() && resolve_type(paths[shared->second]) == resolve_type(p))
 			{
-				SFG_ASSERT(false, "no metadata found associated with this tag: {0}", ext);
-				continue;
+				index_by_sid[sid] = shared->second;
+				aliases.push_back({shared->second, p});
+				return static_cast<int32>(shared->second);
 			}
 
-			const string_id type   = m->get_type_id();
-			void*			loader = nullptr;
+			const uint32 index = static_cast<uint32>(paths.size());
+			index_by_sid[sid]  = index;
+			if (shared == index_by_blob.end())
+				index_by_blob[blob] = index;
+			paths.push_back(p);
+			return static_cast<int32>(index);
+		};
 
-			const resource_handle h = get_resource_handle_by_hash_if_exists(type, TO_SID(path));
-			if (!h.is_null())
-				continue;
-
-			istream stream;
-			if (!pkg.get_stream(sid, stream))
-				continue;
-
-			loader				= load_from_stream(type, stream);
-			resolved_loaders[i] = loader;
-			resolved_types[i]	= type;
-		}
+		for (const string& p : relative_paths)
+			add_path(p);
 
-		// create actual resources.
-		const uint32   max_passes = _max_load_priority + 1;
-		vector<string> dependencies;
-		vector<string> out_subs = {};
+		vector<void*>		   resolved_loaders;
+		vector<string_id>	   resolved_types;
+		vector<vector<string>> resolved_subs;
+		vector<vector<uint32>> dependencies;
+		vector<int>			   indices;
 
-		for (uint32 pass = 0; pass < max_passes; pass++)
+		// decompress and deserialize level by level, sub-resources found in one level form the next.
+		uint32 begin = 0;
+		while (begin < static_cast<uint32>(paths.size()))
 		{
-			for (uint32 i = 0; i < size; i++)
-			{
-				const string&	p	   = filtered_relative_paths[i];
-				const string_id type   = resolved_types[i];
-				void*			loader = resolved_loaders[i];
+			const uint32 end = static_cast<uint32>(paths.size());
+			resolved_loaders.resize(end, nullptr);
+			resolved_types.resize(end, 0);
+			resolved_subs.resize(end);
+			dependencies.resize(end);
+
+			indices.resize(end - begin);
+			std::iota(indices.begin(), indices.end(), static_cast<int>(begin));
+
+			std::for_each(std::execution::par, indices.begin(), indices.end(), [&](int i) {
+				const string&	path = paths[i];
+				const string_id sid	 = TO_SID(path);
+				const size_t	dot	 = path.find_last_of(".");
+				if (dot == string::npos)
+				{
+					SFG_ERR("could not deduce extension: {0}", path);
+					return;
+				}
 
-				if (loader == nullptr)
+				const string ext = path.substr(dot + 1, path.size() - dot - 1);
+				const meta*	 m	 = reflection::get().find_by_tag(ext.c_str());
+				if (m == nullptr)
 				{
-					continue;
+					SFG_ASSERT(false, "no metadata found associated with this tag: {0}", ext);
+					return;
 				}
 
-				const cache_storage& stg = get_storage(type);
-				if (pass != stg.load_priority)
+				const string_id		  type = m->get_type_id();
+				const resource_handle h	   = get_resource_handle_by_hash_if_exists(type, sid);
+				if (!h.is_null())
+					return;
+
+				// every index is a distinct entry, so decompression into the package's entry buffers does not race.
+				istream stream;
+				if (!pkg.get_stream(sid, stream))
+					return;
+
+				// the entry is released only after its resource is created, loaders may resolve arrays in place.
+				stream.set_persistent(true);
+
+				void* loader		= load_from_stream(type, stream);
+				resolved_loaders[i] = loader;
+				resolved_types[i]	= type;
+				get_loader_sub_resources(type, loader, resolved_subs[i]);
+			});
+
+			for (uint32 i = begin; i < end; i++)
+			{
+				for (const string& sub : resolved_subs[i])
 				{
-					continue;
+					const int32 dep = add_path(sub);
+					if (dep != -1 && dep != static_cast<int32>(i))
+						dependencies[i].push_back(static_cast<uint32>(dep));
 				}
+			}
 
-				out_subs.resize(0);
-				get_loader_sub_resources(type, loader, out_subs);
-				if (!out_subs.empty())
-					load_resources(out_subs, pkg);
+			begin = end;
+		}
 
-				const string_id hash = TO_SID(p);
+		// create on this thread in priority waves, a resource waits until all of its sub-resources exist.
+		const uint32 size		= static_cast<uint32>(paths.size());
+		const uint32 max_passes = _max_load_priority + 1;
+		uint32		 remaining	= static_cast<uint32>(std::count_if(resolved_loaders.begin(), resolved_loaders.end(), [](void* l) -> bool { return l != nullptr; }));
+		bool		 progressed = true;
 
-				resource_handle handle = {};
-				handle				   = add_from_loader(type, loader, pass, hash);
-				if (handle.is_null())
-					continue;
+		while (remaining != 0 && progressed)
+		{
+			progressed = false;
 
-				SFG_INFO("loaded resource: {0}", p.c_str());
-				// store by hash-path
-				store_relative_path(type, handle, p);
-				delete_loader(type, loader);
-				resolved_loaders[i] = nullptr;
+			for (uint32 pass = 0; pass < max_passes; pass++)
+			{
+				for (uint32 i = 0; i < size; i++)
+				{
+					void* loader = resolved_loaders[i];
+					if (loader == nullptr)
+						continue;
+
+					const string_id		 type = resolved_types[i];
+					const cache_storage& stg  = get_storage(type);
+					if (pass != stg.load_priority)
+						continue;
+
+					auto pending = std::find_if(dependencies[i].begin(), dependencies[i].end(), [&](uint32 dep) -> bool { return resolved_loaders[dep] != nullptr; });
+					if (pending != dependencies[i].end())
+						continue;
+
+					const string&	p	 = paths[i];
+					const string_id hash = TO_SID(p);
+
+					resolved_loaders[i] = nullptr;
+					remaining--;
+					progressed = true;
+
+					const resource_handle handle = add_from_loader(type, loader, pass, hash);
+					if (handle.is_null())
+					{
+						SFG_ERR("failed creating resource: {0}", p.c_str());
+						delete_loader(type, loader);
+						pkg.release_entry(hash);
+						continue;
+					}
+
+					SFG_INFO("loaded resource: {0}", p.c_str());
+					// store by hash-path
+					store_relative_path(type, handle, p);
+					delete_loader(type, loader);
+
+					// resource owns its data now, hand the entry's pages back.
+					pkg.release_entry(hash);
+				}
 			}
 		}
+
+		for (uint32 i = 0; i < size; i++)
+		{
+			if (resolved_loaders[i] == nullptr)
+				continue;
+
+			SFG_ERR("circular resource dependency, skipping: {0}", paths[i].c_str());
+			delete_loader(resolved_types[i], resolved_loaders[i]);
+		}
+
+		for (const pair<uint32, string>& alias : aliases)
+		{
+			const string_id		  type	 = resolve_type(alias.second);
+			const resource_handle handle = get_resource_handle_by_hash_if_exists(type, TO_SID(paths[alias.first]));
+			if (handle.is_null() || !get_resource_handle_by_hash_if_exists(type, TO_SID(alias.second)).is_null())
+				continue;
+
+			SFG_INFO("aliased resource: {0} -> {1}", alias.second.c_str(), paths[alias.first].c_str());
+			add_resource_alias(type, handle, alias.second);
+		}
 	}
 
 #ifdef SFG_TOOLMODE
@@ -461,7 +582,12 @@ namespace SFG
 				resource_handle handle = {};
 				handle				   = add_from_loader(type, loader, pass, hash);
 				if (handle.is_null())
+				{
+					SFG_ERR("failed creating resource: {0}", p.c_str());
+					delete_loader(type, loader);
+					resolved_loaders[i] = nullptr;
 					continue;
+				}
 
 				SFG_INFO("loaded resource: {0}", p.c_str());
 
@@ -644,6 +770,40 @@ namespace SFG
 		return stg.cache_ptr->remove(handle);
 	}
 
+	void resource_manager::unload_resource(string_id type, string_id hash)
+	{
+		const resource_handle handle = get_resource_handle_by_hash_if_exists(type, hash);
+		if (handle.is_null())
+			return;
+
+		// shared through a package alias, only this path goes away while the others still use the resource.
+		if (get_storage(type).cache_ptr->release_alias(hash, handle))
+			return;
+
+		destroy(type, handle);
+		remove_resource(type, handle);
+	}
+
+	string_id resource_manager::resolve_type(const string& relative_path) const
+	{
+		const size_t dot = relative_path.find_last_of(".");
+		if (dot == string::npos)
+		{
+			SFG_ERR("could not deduce extension: {0}", relative_path);
+			return 0;
+		}
+
+		const string ext = relative_path.substr(dot + 1, relative_path.size() - dot - 1);
+		const meta*	 m	 = reflection::get().find_by_tag(ext.c_str());
+		if (m == nullptr)
+		{
+			SFG_ERR("no metadata found associated with this tag: {0}", ext);
+			return 0;
+		}
+
+		return m->get_type_id();
+	}
+
 	void* resource_manager::get_resource(string_id type, resource_handle handle) const
 	{
 		const cache_storage& stg = get_storage(type);
@@ -759,6 +919,14 @@ namespace SFG
 		get_storage(type).cache_ptr->_paths_by_hashes[hash] = p;
 	}
 
+	void resource_manager::add_resource_alias(string_id type, resource_handle handle, const string& p)
+	{
+		const string_id		 hash  = TO_SID(p);
+		resource_cache_base* cache = get_storage(type).cache_ptr;
+		cache->add_alias(hash, handle);
+		cache->_paths_by_hashes[hash] = p;
+	}
+
 	const resource_manager::cache_storage& resource_manager::get_storage(string_id type) const
 	{
 		auto it = std::find_if(_storages.begin(), _storages.end(), [type](const cache_storage& stg) -> bool { return stg.type == type; });
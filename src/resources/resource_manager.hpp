@@ -79,6 +79,8 @@ namespace SFG
 		virtual void			delete_loader(void* loader) const									   = 0;
 		virtual void			destroy(resource_handle handle, world& w)							   = 0;
 		virtual resource_handle add(string_id hash)													   = 0;
+		virtual void			add_alias(string_id hash, resource_handle handle)					   = 0;
+		virtual bool			release_alias(string_id hash, resource_handle handle)				   = 0;
 		virtual void			remove(resource_handle handle)										   = 0;
 		virtual void			reset(world& w)														   = 0;
 
@@ -101,6 +103,9 @@ namespace SFG
 
 		hash_map<string_id, resource_handle> _by_hashes;
 		hash_map<string_id, string>			 _paths_by_hashes;
+
+		// extra hashes sharing a resource created under another one, package entries with identical payloads.
+		hash_map<string_id, resource_handle> _aliases;
 	};
 
 	// -----------------------------------------------------------------------------
@@ -203,30 +208,72 @@ namespace SFG
 		{
 			resource_handle handle = _resources.add();
 			_by_hashes[hash]	   = handle;
+			_hashes[handle.index]  = hash;
 			return handle;
 		}
 
+		void add_alias(string_id hash, resource_handle handle) override
+		{
+			_by_hashes[hash] = handle;
+			_aliases[hash]	 = handle;
+			_alias_counts[handle.index]++;
+		}
+
+		bool release_alias(string_id hash, resource_handle handle) override
+		{
+			if (_alias_counts[handle.index] == 0)
+				return false;
+
+			auto it = _aliases.find(hash);
+			if (it == _aliases.end())
+			{
+				// the hash that created the resource goes first, one of its aliases takes its place.
+				it = std::find_if(_aliases.begin(), _aliases.end(), [handle](const auto& a) -> bool { return a.second == handle; });
+				SFG_ASSERT(it != _aliases.end());
+				_hashes[handle.index] = it->first;
+			}
+
+			_aliases.erase(it);
+			_alias_counts[handle.index]--;
+			_by_hashes.erase(hash);
+			_paths_by_hashes.erase(hash);
+			return true;
+		}
+
 		void remove(resource_handle handle) override
 		{
 			_resources.remove(handle);
 
-			// linear scan :/
-			auto it = _by_hashes.begin();
-			for (; it != _by_hashes.end(); ++it)
+			if (_alias_counts[handle.index] != 0)
 			{
-				if (it->second == handle)
+				for (auto it = _aliases.begin(); it != _aliases.end();)
 				{
-#ifdef SFG_TOOLMODE
-					auto it2 = _paths_by_hashes.find(it->first);
-					if (it2 != _paths_by_hashes.end())
-						_paths_by_hashes.erase(it2);
-#endif
-
-					_by_hashes.erase(it);
-
-					break;
+					if (!(it->second == handle))
+					{
+						++it;
+						continue;
+					}
+
+					_by_hashes.erase(it->first);
+					_paths_by_hashes.erase(it->first);
+					it = _aliases.erase(it);
 				}
+				_alias_counts[handle.index] = 0;
 			}
+
+			const string_id hash  = _hashes[handle.index];
+			_hashes[handle.index] = 0;
+
+			// the same hash may have been re-added for a newer handle since, that mapping stays.
+			auto it = _by_hashes.find(hash);
+			if (it == _by_hashes.end() || !(it->second == handle))
+				return;
+
+			_by_hashes.erase(it);
+
+#ifdef SFG_TOOLMODE
+			_paths_by_hashes.erase(hash);
+#endif
 		}
 
 		void reset(world& w) override
@@ -240,7 +287,14 @@ namespace SFG
 				++it;
 			}
 			_by_hashes.clear();
+			_aliases.clear();
 			_resources.reset();
+
+			for (int i = 0; i < MAX_COUNT; i++)
+			{
+				_hashes[i]		 = 0;
+				_alias_counts[i] = 0;
+			}
 		}
 
 		// -----------------------------------------------------------------------------
@@ -284,12 +338,7 @@ namespace SFG
 
 		string_id get_hash(resource_handle handle) const override
 		{
-			for (const auto& [sid, hnd] : _by_hashes)
-			{
-				if (hnd == handle)
-					return sid;
-			}
-			return 0;
+			return _resources.is_valid(handle) ? _hashes[handle.index] : 0;
 		}
 
 		bool is_valid(resource_handle handle) const override
@@ -341,6 +390,8 @@ namespace SFG
 
 	private:
 		pool_type _resources;
+		string_id _hashes[MAX_COUNT]	   = {};
+		uint16	  _alias_counts[MAX_COUNT] = {};
 	};
 
 	// -----------------------------------------------------------------------------
@@ -350,6 +401,8 @@ namespace SFG
 	class resource_manager
 	{
 	private:
+		friend class resource_streamer;
+
 		struct cache_storage
 		{
 			resource_cache_base* cache_ptr	   = nullptr;
@@ -393,11 +446,16 @@ namespace SFG
 		// -----------------------------------------------------------------------------
 
 		resource_handle get_or_add_sampler(const sampler_desc& desc);
+		void			register_sampler(const sampler_desc& desc, resource_handle handle);
+		void			unregister_sampler(const sampler_desc& desc, resource_handle handle);
 		void			load_resources(const vector<string>& relative_paths, package& pkg);
 		resource_handle add_resource(string_id type, string_id hash);
 		void			remove_resource(string_id type, resource_handle handle);
+		void			unload_resource(string_id type, string_id hash);
 		bool			is_valid(string_id type, resource_handle handle) const;
 		void			store_relative_path(string_id type, resource_handle handle, const string& p);
+		void			add_resource_alias(string_id type, resource_handle handle, const string& p);
+		string_id		resolve_type(const string& relative_path) const;
 
 		template <typename T> inline resource_handle add_resource(string_id hash)
 		{
@@ -470,6 +528,11 @@ namespace SFG
 			return _aux_memory;
 		}
 
+		inline uint32 get_load_priority(string_id type) const
+		{
+			return get_storage(type).load_priority;
+		}
+
 		inline resource_handle get_default_gui_mat() const
 		{
 			return _default_gui_mat;
@@ -636,6 +699,10 @@ namespace SFG
 		uint32				  _max_load_priority	   = 0;
 		uint32				  _dynamic_sampler_count   = 0;
 
+		// every live sampler by descriptor key, texture_sampler registers on create and unregisters on destroy.
+		// samplers with equal descriptors share a key, lookups take the first one that is still live.
+		hash_map<uint64, vector<resource_handle>> _samplers_by_desc;
+
 		// raws for defaults
 		texture_raw _dummy_color_raw   = {};
 		texture_raw _dummy_orm_raw	   = {};
@@ -0,0 +1,478 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "resource_streamer.hpp"
+#include "resource_manager.hpp"
+#include "app/package.hpp"
+#include "data/istream.hpp"
+#include "platform/time.hpp"
+#include "io/log.hpp"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+namespace SFG
+{
+	resource_streamer::resource_streamer(resource_manager& rm) : _resource_manager(rm)
+	{
+	}
+
+	resource_streamer::~resource_streamer()
+	{
+		uninit();
+	}
+
+	void resource_streamer::init(package& pkg)
+	{
+		uninit();
+
+		_package	 = &pkg;
+		_should_exit = 0;
+
+		const uint32 count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, static_cast<uint32>(RESOURCE_STREAMER_MAX_WORKERS));
+		for (uint32 i = 0; i < count; i++)
+			_workers.push_back(std::thread(&resource_streamer::worker_loop, this));
+	}
+
+	void resource_streamer::uninit()
+	{
+		if (_package == nullptr)
+			return;
+
+		{
+			LOCK_GUARD(_mtx);
+			_should_exit = 1;
+		}
+		_cv.notify_all();
+
+		for (std::thread& t : _workers)
+			t.join();
+		_workers.clear();
+
+		for (const decoded& d : _decoded)
+		{
+			if (d.loader != nullptr)
+				_resource_manager.delete_loader(d.type, d.loader);
+		}
+
+		for (const auto& [sid, p] : _pending)
+		{
+			if (p.loader != nullptr)
+				_resource_manager.delete_loader(p.type, p.loader);
+		}
+
+		_jobs.clear();
+		_decoded.clear();
+		_pending.clear();
+		_requests.clear();
+		_completed.clear();
+		_package = nullptr;
+	}
+
+	void resource_streamer::tick()
+	{
+		if (_package == nullptr)
+			return;
+
+		ZoneScoped;
+
+		static vector<decoded>			   reuse_decoded;
+		static vector<string_id>		   reuse_ready;
+		static vector<resource_request_id> reuse_completed;
+
+		{
+			LOCK_GUARD(_mtx);
+			reuse_decoded.swap(_decoded);
+		}
+
+		// link decoded loaders, sub-resources become pending entries serving the same waiters.
+		for (const decoded& d : reuse_decoded)
+		{
+			auto it = _pending.find(d.sid);
+			if (it == _pending.end() || it->second.waiters.empty())
+			{
+				discard(d.type, d.sid, d.loader);
+				if (it != _pending.end())
+					_pending.erase(it);
+				continue;
+			}
+
+			if (d.loader == nullptr)
+			{
+				discard(d.type, d.sid, nullptr);
+				finish(d.sid, false);
+				continue;
+			}
+
+			it->second.loader	 = d.loader;
+			it->second.size		 = d.size;
+			const uint8 priority = it->second.priority;
+
+			for (const string& sub : d.subs)
+			{
+				const string_id dep = track(sub, priority);
+				if (dep == 0 || dep == d.sid)
+					continue;
+
+				// tracking may have grown the map, look the parent up again.
+				pending& parent = _pending.at(d.sid);
+				parent.dependencies.push_back(dep);
+				for (resource_request_id id : parent.waiters)
+					add_waiter(dep, id, priority);
+			}
+		}
+		reuse_decoded.clear();
+
+		// create by request priority then load priority, a resource waits until its sub-resources exist.
+		// at least one resource is created per tick so tiny budgets still make progress.
+		const int64 begin_us	= time::get_cpu_microseconds();
+		const int64 budget_us	= static_cast<int64>(_budget_ms * 1000.0f);
+		uint64		bytes		= 0;
+		bool		over_budget = false;
+		bool		progressed	= true;
+
+		while (progressed && !over_budget)
+		{
+			progressed = false;
+
+			reuse_ready.resize(0);
+			for (const auto& [sid, p] : _pending)
+			{
+				if (p.loader != nullptr)
+					reuse_ready.push_back(sid);
+			}
+
+			std::sort(reuse_ready.begin(), reuse_ready.end(), [this](string_id a, string_id b) -> bool {
+				const pending& pa = _pending.at(a);
+				const pending& pb = _pending.at(b);
+				if (pa.priority != pb.priority)
+					return pa.priority < pb.priority;
+				return _resource_manager.get_storage(pa.type).load_priority < _resource_manager.get_storage(pb.type).load_priority;
+			});
+
+			for (string_id sid : reuse_ready)
+			{
+				const pending& p	   = _pending.at(sid);
+				auto		   waiting = std::find_if(p.dependencies.begin(), p.dependencies.end(), [this](string_id dep) -> bool { return _pending.find(dep) != _pending.end(); });
+				if (waiting != p.dependencies.end())
+					continue;
+
+				const uint32		  load_priority = _resource_manager.get_storage(p.type).load_priority;
+				const resource_handle handle		= _resource_manager.add_from_loader(p.type, p.loader, load_priority, sid);
+				if (!handle.is_null())
+				{
+					SFG_INFO("streamed resource: {0}", p.path.c_str());
+					_resource_manager.store_relative_path(p.type, handle, p.path);
+				}
+
+				// resource owns its data now, hand the entry's pages back.
+				bytes += p.size;
+				discard(p.type, sid, p.loader);
+				finish(sid, !handle.is_null());
+				progressed = true;
+
+				if (bytes >= _budget_bytes || time::get_cpu_microseconds() - begin_us >= budget_us)
+				{
+					over_budget = true;
+					break;
+				}
+			}
+		}
+
+		// nothing left to decode and nothing creatable, the remaining loaders wait on each other.
+		const bool all_decoded = std::all_of(_pending.begin(), _pending.end(), [](const auto& e) -> bool { return e.second.loader != nullptr; });
+		if (!over_budget && all_decoded && !_pending.empty())
+		{
+			reuse_ready.resize(0);
+			for (const auto& [sid, p] : _pending)
+				reuse_ready.push_back(sid);
+
+			for (string_id sid : reuse_ready)
+			{
+				const pending& p = _pending.at(sid);
+				SFG_ERR("circular resource dependency, skipping: {0}", p.path.c_str());
+				discard(p.type, sid, p.loader);
+				finish(sid, false);
+			}
+		}
+
+		// callbacks may issue new requests, which land in the next tick.
+		reuse_completed.swap(_completed);
+		for (resource_request_id id : reuse_completed)
+		{
+			auto it = _requests.find(id);
+			if (it == _requests.end())
+				continue;
+
+			const request_state state = it->second;
+			_requests.erase(it);
+
+			if (state.callback != nullptr)
+				state.callback(id, state.failed ? resource_request_status::failed : resource_request_status::complete, state.user_data);
+		}
+		reuse_completed.clear();
+	}
+
+	resource_request_id resource_streamer::request(const vector<string>& relative_paths, resource_request_priority priority, resource_request_callback callback, void* user_data)
+	{
+		if (_package == nullptr)
+		{
+			SFG_ERR("resource streamer is not running, request ignored.");
+			return NULL_RESOURCE_REQUEST;
+		}
+
+		const resource_request_id id = _next_request++;
+		if (_next_request == NULL_RESOURCE_REQUEST)
+			_next_request++;
+
+		_requests[id] = {
+			.callback  = callback,
+			.user_data = user_data,
+		};
+
+		const uint8 prio = static_cast<uint8>(priority);
+		for (const string& p : relative_paths)
+		{
+			const string_id sid = track(p, prio);
+			if (sid != 0)
+				add_waiter(sid, id, prio);
+		}
+
+		// everything is resident already, still reported from tick like any other completion.
+		if (_requests.at(id).outstanding == 0)
+			_completed.push_back(id);
+
+		return id;
+	}
+
+	void resource_streamer::cancel(resource_request_id id)
+	{
+		auto req = _requests.find(id);
+		if (req == _requests.end())
+			return;
+		_requests.erase(req);
+		_completed.erase(std::remove(_completed.begin(), _completed.end(), id), _completed.end());
+
+		static vector<string_id> reuse_dropped;
+		reuse_dropped.resize(0);
+
+		for (auto& [sid, p] : _pending)
+		{
+			auto it = std::find(p.waiters.begin(), p.waiters.end(), id);
+			if (it == p.waiters.end())
+				continue;
+
+			p.waiters.erase(it);
+			if (p.waiters.empty())
+				reuse_dropped.push_back(sid);
+		}
+
+		for (string_id sid : reuse_dropped)
+		{
+			const pending& p = _pending.at(sid);
+			if (p.loader != nullptr)
+			{
+				discard(p.type, sid, p.loader);
+				_pending.erase(sid);
+				continue;
+			}
+
+			// a job a worker already took stays pending without waiters and is dropped once it lands.
+			LOCK_GUARD(_mtx);
+			auto job_it = std::find_if(_jobs.begin(), _jobs.end(), [sid](const job& j) -> bool { return j.sid == sid; });
+			if (job_it == _jobs.end())
+				continue;
+
+			_jobs.erase(job_it);
+			std::make_heap(_jobs.begin(), _jobs.end(), job_after);
+			_pending.erase(sid);
+		}
+	}
+
+	bool resource_streamer::is_pending(resource_request_id id) const
+	{
+		return _requests.find(id) != _requests.end();
+	}
+
+	bool resource_streamer::job_after(const job& a, const job& b)
+	{
+		// max-heap on urgency, lower priority values first and fifo within the same priority.
+		if (a.priority != b.priority)
+			return a.priority > b.priority;
+		return a.order > b.order;
+	}
+
+	void resource_streamer::worker_loop()
+	{
+#ifdef TRACY_ENABLE
+		tracy::SetThreadName("resource_streamer");
+#endif
+
+		while (true)
+		{
+			job j = {};
+
+			{
+				std::unique_lock<mutex> lock(_mtx);
+				_cv.wait(lock, [this]() -> bool { return _should_exit != 0 || !_jobs.empty(); });
+				if (_should_exit != 0)
+					return;
+
+				std::pop_heap(_jobs.begin(), _jobs.end(), job_after);
+				j = std::move(_jobs.back());
+				_jobs.pop_back();
+			}
+
+			ZoneScopedN("resource_streamer_decode");
+
+			// a sid is never queued twice while pending, so decompression into the entry buffers does not race.
+			decoded d = {
+				.sid  = j.sid,
+				.type = j.type,
+			};
+
+			istream stream;
+			if (_package->get_stream(j.sid, stream))
+			{
+				// entries are released in discard(), after creation, so loaders may resolve arrays in place.
+				stream.set_persistent(true);
+				d.loader = _resource_manager.load_from_stream(j.type, stream);
+				d.size	 = _package->get_entry(j.sid)->uncompressed_size;
+				if (d.loader != nullptr)
+					_resource_manager.get_loader_sub_resources(j.type, d.loader, d.subs);
+			}
+			else
+				SFG_ERR("failed finding from package: {0}", j.path);
+
+			LOCK_GUARD(_mtx);
+			_decoded.push_back(std::move(d));
+		}
+	}
+
+	void resource_streamer::push_job(const pending& p, string_id sid)
+	{
+		{
+			LOCK_GUARD(_mtx);
+			_jobs.push_back({
+				.path	  = p.path,
+				.sid	  = sid,
+				.type	  = p.type,
+				.order	  = _job_order++,
+				.priority = p.priority,
+			});
+			std::push_heap(_jobs.begin(), _jobs.end(), job_after);
+		}
+		_cv.notify_one();
+	}
+
+	void resource_streamer::add_waiter(string_id sid, resource_request_id id, uint8 priority)
+	{
+		auto it = _pending.find(sid);
+		if (it == _pending.end())
+			return;
+
+		pending& p = it->second;
+		if (std::find(p.waiters.begin(), p.waiters.end(), id) != p.waiters.end())
+			return;
+
+		p.waiters.push_back(id);
+		_requests.at(id).outstanding++;
+
+		// a more urgent waiter pulls a queued job forward.
+		if (priority < p.priority)
+		{
+			p.priority = priority;
+
+			LOCK_GUARD(_mtx);
+			auto job_it = std::find_if(_jobs.begin(), _jobs.end(), [sid](const job& j) -> bool { return j.sid == sid; });
+			if (job_it != _jobs.end())
+			{
+				job_it->priority = priority;
+				std::make_heap(_jobs.begin(), _jobs.end(), job_after);
+			}
+		}
+
+		// known sub-resources serve the waiter too, so cancelling another request never strands them.
+		for (string_id dep : p.dependencies)
+			add_waiter(dep, id, priority);
+	}
+
+	void resource_streamer::finish(string_id sid, bool success)
+	{
+		auto it = _pending.find(sid);
+		if (it == _pending.end())
+			return;
+
+		const vector<resource_request_id> waiters = std::move(it->second.waiters);
+		_pending.erase(it);
+
+		for (resource_request_id id : waiters)
+		{
+			auto req = _requests.find(id);
+			if (req == _requests.end())
+				continue;
+
+			request_state& state = req->second;
+			if (!success)
+				state.failed = 1;
+
+			state.outstanding--;
+			if (state.outstanding == 0)
+				_completed.push_back(id);
+		}
+	}
+
+	void resource_streamer::discard(string_id type, string_id sid, void* loader)
+	{
+		if (loader != nullptr)
+			_resource_manager.delete_loader(type, loader);
+		_package->release_entry(sid);
+	}
+
+	string_id resource_streamer::track(const string& relative_path, uint8 priority)
+	{
+		if (relative_path.empty())
+			return 0;
+
+		const string_id type = _resource_manager.resolve_type(relative_path);
+		if (type == 0)
+			return 0;
+
+		const string_id sid = TO_SID(relative_path);
+		if (_pending.find(sid) != _pending.end())
+			return sid;
+
+		if (!_resource_manager.get_resource_handle_by_hash_if_exists(type, sid).is_null())
+			return 0;
+
+		pending& p = _pending[sid];
+		p.path	   = relative_path;
+		p.type	   = type;
+		p.priority = priority;
+		push_job(p, sid);
+		return sid;
+	}
+}
@@ -0,0 +1,167 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "common/string_id.hpp"
+#include "data/string.hpp"
+#include "data/vector.hpp"
+#include "data/hash_map.hpp"
+#include "data/mutex.hpp"
+
+#include <thread>
+#include <condition_variable>
+
+namespace SFG
+{
+	class resource_manager;
+	class package;
+
+#define RESOURCE_STREAMER_MAX_WORKERS  4
+#define RESOURCE_STREAMER_BUDGET_MS	   2.0f
+#define RESOURCE_STREAMER_BUDGET_BYTES (32 * 1024 * 1024)
+#define NULL_RESOURCE_REQUEST		   0
+
+	typedef uint32 resource_request_id;
+
+	enum class resource_request_priority : uint8
+	{
+		critical = 0,
+		high,
+		normal,
+		low,
+	};
+
+	enum class resource_request_status : uint8
+	{
+		complete,
+		failed,
+	};
+
+	typedef void (*resource_request_callback)(resource_request_id id, resource_request_status status, void* user_data);
+
+	/*
+	 * Streams package resources in the background. Workers decompress and deserialize loaders in priority order,
+	 * tick() creates them on the owning thread within a time and byte budget, dependencies first.
+	 * Cancelling only drops work that has not been created yet, created resources belong to the resource manager.
+	 */
+	class resource_streamer
+	{
+	private:
+		struct job
+		{
+			string	  path	   = "";
+			string_id sid	   = 0;
+			string_id type	   = 0;
+			uint64	  order	   = 0;
+			uint8	  priority = 0;
+		};
+
+		struct decoded
+		{
+			string_id	   sid	  = 0;
+			string_id	   type	  = 0;
+			void*		   loader = nullptr;
+			uint64		   size	  = 0;
+			vector<string> subs	  = {};
+		};
+
+		struct pending
+		{
+			string						path		 = "";
+			string_id					type		 = 0;
+			void*						loader		 = nullptr;
+			uint64						size		 = 0;
+			vector<string_id>			dependencies = {};
+			vector<resource_request_id> waiters		 = {};
+			uint8						priority	 = 0;
+		};
+
+		struct request_state
+		{
+			resource_request_callback callback	  = nullptr;
+			void*					  user_data	  = nullptr;
+			uint32					  outstanding = 0;
+			uint8					  failed	  = 0;
+		};
+
+	public:
+		resource_streamer() = delete;
+		resource_streamer(resource_manager& rm);
+		~resource_streamer();
+
+		void init(package& pkg);
+		void uninit();
+		void tick();
+
+		resource_request_id request(const vector<string>& relative_paths, resource_request_priority priority, resource_request_callback callback = nullptr, void* user_data = nullptr);
+		void				cancel(resource_request_id id);
+		bool				is_pending(resource_request_id id) const;
+
+		inline void set_budget(float milliseconds, uint64 bytes)
+		{
+			_budget_ms	  = milliseconds;
+			_budget_bytes = bytes;
+		}
+
+		inline bool is_running() const
+		{
+			return _package != nullptr;
+		}
+
+	private:
+		static bool job_after(const job& a, const job& b);
+
+		void	  worker_loop();
+		void	  push_job(const pending& p, string_id sid);
+		void	  add_waiter(string_id sid, resource_request_id id, uint8 priority);
+		void	  finish(string_id sid, bool success);
+		void	  discard(string_id type, string_id sid, void* loader);
+		string_id track(const string& relative_path, uint8 priority);
+
+	private:
+		resource_manager& _resource_manager;
+		package*		  _package = nullptr;
+
+		// shared with workers, guarded by _mtx.
+		vector<std::thread>		_workers;
+		mutex					_mtx;
+		std::condition_variable _cv;
+		vector<job>				_jobs		 = {};
+		vector<decoded>			_decoded	 = {};
+		uint64					_job_order	 = 0;
+		uint8					_should_exit = 0;
+
+		// owning thread only.
+		hash_map<string_id, pending>				 _pending;
+		hash_map<resource_request_id, request_state> _requests;
+		vector<resource_request_id>					 _completed	   = {};
+		resource_request_id							 _next_request = 1;
+		float										 _budget_ms	   = RESOURCE_STREAMER_BUDGET_MS;
+		uint64										 _budget_bytes = RESOURCE_STREAMER_BUDGET_BYTES;
+	};
+}
@@ -33,10 +33,12 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "editor/editor_settings.hpp"
 #include "gfx/backend/backend.hpp"
 #include "serialization/serialization.hpp"
+#include "resources/common_resources.hpp"
 #include "common/string_id.hpp"
 #include "shader_variant_compiler.hpp"
 #include "vendor/nhlohmann/json.hpp"
 #include <fstream>
+#include <algorithm>
 using json = nlohmann::json;
 #endif
 
@@ -45,6 +47,37 @@ namespace SFG
 
 #ifdef SFG_TOOLMODE
 
+	namespace
+	{
+		// mirrors the compiler's lookup: the including file's folder first, then the include folders in order.
+		void collect_includes(const string& full_path, const vector<string>& folder_paths, vector<string>& out_paths)
+		{
+			const string text = file_system::read_file_as_string(full_path.c_str());
+			const string dir  = file_system::get_directory_of_file(full_path.c_str());
+
+			size_t pos = text.find("#include");
+			while (pos != string::npos)
+			{
+				const size_t open  = text.find_first_of("\"\n", pos + 8);
+				const size_t close = open == string::npos || text[open] != '"' ? string::npos : text.find('"', open + 1);
+				pos				   = text.find("#include", pos + 8);
+				if (close == string::npos)
+					continue;
+
+				const string include  = text.substr(open + 1, close - open - 1);
+				string		 resolved = dir + include;
+				for (size_t i = 0; i < folder_paths.size() && !file_system::exists(resolved.c_str()); i++)
+					resolved = folder_paths[i] + include;
+
+				if (!file_system::exists(resolved.c_str()) || std::find(out_paths.begin(), out_paths.end(), resolved) != out_paths.end())
+					continue;
+
+				out_paths.push_back(resolved);
+				collect_includes(resolved, folder_paths, out_paths);
+			}
+		}
+	}
+
 	bool shader_raw::compile_specialized(const string& shader_text, const vector<string>& folder_paths, const string& variant_style)
 	{
 		if (variant_style.compare("gbuffer_object") == 0)
@@ -116,6 +149,18 @@ namespace SFG
 			folder_paths.push_back(folder_path);
 			folder_paths.push_back(root);
 
+			vector<string> include_paths;
+			collect_includes(full_source, folder_paths, include_paths);
+
+			// engine includes may live outside the base directory, those are kept relative to it as well.
+			source_dependencies.resize(0);
+			for (const string& include : include_paths)
+			{
+				string relative = include.compare(0, wd.size(), wd) == 0 ? include.substr(wd.size()) : file_system::get_relative(wd.c_str(), include.c_str());
+				file_system::fix_path(relative);
+				source_dependencies.push_back(relative);
+			}
+
 			if (json_data.find("desc") != json_data.end())
 			{
 				const shader_desc default_desc = json_data.value<shader_desc>("desc", {});
@@ -161,26 +206,43 @@ namespace SFG
 
 		istream stream = serialization::load_from_file(meta_cache_path.c_str());
 
-		string file_path				  = "";
-		string source_path				  = "";
-		uint64 saved_file_last_modified	  = 0;
-		uint64 saved_source_last_modified = 0;
+		if (!read_cache_version(stream))
+			return false;
+
+		string		   file_path						= "";
+		string		   source_path						= "";
+		uint64		   saved_file_last_modified			= 0;
+		uint64		   saved_source_last_modified		= 0;
+		vector<string> saved_dependencies				= {};
+		vector<uint64> saved_dependencies_last_modified = {};
 		stream >> file_path;
 		stream >> source_path;
 		stream >> saved_file_last_modified;
 		stream >> saved_source_last_modified;
+		stream >> saved_dependencies;
+		stream >> saved_dependencies_last_modified;
 
 		stream.destroy();
 
 		const uint64 file_last_modified = file_system::get_last_modified_ticks(file_path);
 		const uint64 src_last_modified	= file_system::get_last_modified_ticks(source_path);
 
-		if (file_last_modified != saved_file_last_modified || src_last_modified != saved_source_last_modified)
+		if (file_last_modified != saved_file_last_modified || src_last_modified != saved_source_last_modified || saved_dependencies.size() != saved_dependencies_last_modified.size())
 			return false;
 
+		// an edited include invalidates the cache just like the source does.
+		const string base = file_path.substr(0, file_path.size() - string(relative_path).size());
+		for (size_t i = 0; i < saved_dependencies.size(); i++)
+		{
+			const string dep = base + saved_dependencies[i];
+			if (file_system::get_last_modified_ticks(dep) != saved_dependencies_last_modified[i])
+				return false;
+		}
+
 		stream = serialization::load_from_file(data_cache_path.c_str());
 		deserialize(stream);
 		stream.destroy();
+		source_dependencies = std::move(saved_dependencies);
 		return true;
 	}
 
@@ -196,11 +258,19 @@ namespace SFG
 		const string meta_cache_path = cache_folder_path + relative + "-" + sid_str + "_meta" + extension;
 		const string data_cache_path = cache_folder_path + relative + "-" + sid_str + "_data" + extension;
 
+		vector<uint64> dependencies_last_modified;
+		dependencies_last_modified.reserve(source_dependencies.size());
+		for (const string& dep : source_dependencies)
+			dependencies_last_modified.push_back(file_system::get_last_modified_ticks(resource_directory_path + dep));
+
 		ostream out_stream;
+		out_stream << RESOURCE_CACHE_VERSION;
 		out_stream << file_path;
 		out_stream << source_path;
 		out_stream << file_last_modified;
 		out_stream << src_last_modified;
+		out_stream << source_dependencies;
+		out_stream << dependencies_last_modified;
 		serialization::save_to_file(meta_cache_path.c_str(), out_stream);
 
 		out_stream.shrink(0);
@@ -213,6 +283,7 @@ namespace SFG
 	void shader_raw::get_dependencies(vector<string>& out_deps) const
 	{
 		out_deps.push_back(source);
+		out_deps.insert(out_deps.end(), source_dependencies.begin(), source_dependencies.end());
 	}
 
 #endif
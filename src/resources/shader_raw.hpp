@@ -46,6 +46,11 @@ namespace SFG
 		bool					is_compute		 = false;
 		bool					persistent_blobs = false;
 
+#ifdef SFG_TOOLMODE
+		// transitive #include closure of source, relative to the base directory. only used for cache invalidation, never cooked.
+		vector<string> source_dependencies = {};
+#endif
+
 		void serialize(ostream& stream) const;
 		void deserialize(istream& stream);
 
@@ -68,6 +68,7 @@ namespace SFG
 
 			ev.nodes.push_back(joint.model_node_index);
 			ev.matrices.push_back(joint.inverse_bind_matrix);
+			ev.radii.push_back(joint.bounds_radius);
 		}
 
 		w.get_render_stream().add_event(
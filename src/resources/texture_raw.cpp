@@ -37,6 +37,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "io/file_system.hpp"
 #include "io/assert.hpp"
 #include "serialization/serialization.hpp"
+#include "resources/common_resources.hpp"
 #include "math/vector2ui16.hpp"
 #include <fstream>
 #include <vendor/nhlohmann/json.hpp>
@@ -189,6 +190,9 @@ namespace SFG
 
 		istream stream = serialization::load_from_file(meta_cache_path.c_str());
 
+		if (!read_cache_version(stream))
+			return false;
+
 		string file_path				  = "";
 		string source_path				  = "";
 		uint64 saved_file_last_modified	  = 0;
@@ -225,6 +229,7 @@ namespace SFG
 		const string data_cache_path = cache_folder_path + relative + "-" + sid_str + "_data" + extension;
 
 		ostream out_stream;
+		out_stream << RESOURCE_CACHE_VERSION;
 		out_stream << file_path;
 		out_stream << source_path;
 		out_stream << file_last_modified;
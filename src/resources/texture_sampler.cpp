@@ -63,6 +63,8 @@ namespace SFG
 			_name = alloc.allocate_text(raw.name);
 #endif
 
+		rm.register_sampler(_desc, handle);
+
 		render_event_sampler stg = {};
 		stg.desc				 = raw.desc;
 
@@ -90,6 +92,8 @@ namespace SFG
 		_name = {};
 #endif
 
+		rm.unregister_sampler(_desc, handle);
+
 		stream.add_event({
 			.index		= static_cast<uint32>(handle.index),
 			.event_type = render_event_type::destroy_sampler,
@@ -29,6 +29,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "math/vector3.hpp"
 #include "math/vector4.hpp"
 #include "math/vector4i.hpp"
+#include "serialization/stream_layout.hpp"
 
 namespace SFG
 {
@@ -46,6 +47,8 @@ namespace SFG
 		void deserialize(istream& stream);
 	};
 
+	SFG_STREAM_LAYOUT_RAW(vertex_static, 48);
+
 	struct vertex_skinned
 	{
 		vector3	 pos		  = vector3::zero;
@@ -59,6 +62,8 @@ namespace SFG
 		void deserialize(istream& stream);
 	};
 
+	SFG_STREAM_LAYOUT_RAW(vertex_skinned, 80);
+
 	struct vertex_simple
 	{
 		vector3 pos	  = vector3::zero;
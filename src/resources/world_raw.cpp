@@ -29,6 +29,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "data/istream.hpp"
 #include "data/ostream_vector.hpp"
 #include "data/istream_vector.hpp"
+#include "data/hash_map.hpp"
 
 #ifdef SFG_TOOLMODE
 #include "io/file_system.hpp"
@@ -40,7 +41,21 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "world/component_manager.hpp"
 #include "resources/entity_template_raw.hpp"
 #include "resources/entity_template_utils.hpp"
+#include "serialization/endianness.hpp"
+#include "common/type_id.hpp"
+#include "world/components/comp_camera.hpp"
+#include "world/components/comp_light.hpp"
+#include "world/components/comp_ambient.hpp"
+#include "world/components/comp_skybox.hpp"
+#include "world/components/comp_post_process.hpp"
+#include "world/components/comp_bloom.hpp"
+#include "world/components/comp_ssao.hpp"
+#include "world/components/comp_physics_settings.hpp"
+#include "world/components/comp_canvas.hpp"
+#include "world/components/comp_character_controller.hpp"
 #include <fstream>
+#include <algorithm>
+#include <cmath>
 #include <vendor/nhlohmann/json.hpp>
 using json = nlohmann::json;
 #endif
@@ -52,21 +67,42 @@ namespace SFG
 		SFG_ASSERT(entities_raw.component_buffer.get_size() == 0);
 	}
 
+	void world_cell_raw::serialize(ostream& stream) const
+	{
+		stream << template_path;
+		stream << resources;
+		stream << x;
+		stream << z;
+	}
+
+	void world_cell_raw::deserialize(istream& stream)
+	{
+		stream >> template_path;
+		stream >> resources;
+		stream >> x;
+		stream >> z;
+	}
+
 	void world_raw::serialize(ostream& stream) const
 	{
 		entities_raw.serialize(stream);
 		stream << extra_resources;
+		stream << cell_size;
+		stream << cells;
 	}
 
 	void world_raw::deserialize(istream& stream)
 	{
 		entities_raw.deserialize(stream);
 		stream >> extra_resources;
+		stream >> cell_size;
+		stream >> cells;
 	}
 
 	void world_raw::destroy()
 	{
 		entities_raw.destroy();
+		cells.resize(0);
 	}
 
 #ifdef SFG_TOOLMODE
@@ -90,6 +126,7 @@ namespace SFG
 			tool_cam_pos	= json_data.value<vector3>("tool_cam_pos", vector3::zero);
 			tool_cam_rot	= json_data.value<quat>("tool_cam_rot", quat::identity);
 			extra_resources = json_data.value<vector<string>>("extra_resources", {});
+			cell_size		= json_data.value<float>("cell_size", 0.0f);
 
 			entity_template_raw::load_from_json(json_data, entities_raw);
 
@@ -124,6 +161,7 @@ namespace SFG
 		j["tool_cam_pos"]	 = w.get_tool_camera_pos();
 		j["tool_cam_rot"]	 = w.get_tool_camera_rot();
 		j["extra_resources"] = w.get_extra_resources();
+		j["cell_size"]		 = w.get_cell_size();
 
 		entity_template_raw::save_to_json(j, w, to_serialize);
 
@@ -146,6 +184,7 @@ namespace SFG
 		destroy();
 
 		extra_resources = w.get_extra_resources();
+		cell_size		= w.get_cell_size();
 
 		// top-level entities
 		vector<world_handle> roots;
@@ -183,5 +222,179 @@ namespace SFG
 		}
 	}
 
+	namespace
+	{
+		inline int32 read_index(const uint8* ptr)
+		{
+			int32 val = 0;
+			SFG_MEMCPY(&val, ptr, sizeof(int32));
+			if (endianness::should_swap())
+				endianness::swap_endian(val);
+			return val;
+		}
+
+		inline void write_index(uint8* ptr, int32 val)
+		{
+			if (endianness::should_swap())
+				endianness::swap_endian(val);
+			SFG_MEMCPY(ptr, &val, sizeof(int32));
+		}
+
+		inline void push_unique(vector<string>& list, const string& p)
+		{
+			if (std::find(list.begin(), list.end(), p) == list.end())
+				list.push_back(p);
+		}
+
+		inline bool is_world_component(string_id type)
+		{
+			return type == type_id<comp_camera>::value || type == type_id<comp_dir_light>::value || type == type_id<comp_ambient>::value || type == type_id<comp_skybox>::value || type == type_id<comp_post_process>::value ||
+				   type == type_id<comp_bloom>::value || type == type_id<comp_ssao>::value || type == type_id<comp_physics_settings>::value || type == type_id<comp_canvas>::value || type == type_id<comp_character_controller>::value;
+		}
+	}
+
+	void world_raw::partition_cells(const string& world_path, vector<entity_template_raw>& out_templates)
+	{
+		cells.resize(0);
+
+		const uint32 count = static_cast<uint32>(entities_raw.entities.size());
+		if (cell_size <= 0.0f || count == 0)
+			return;
+
+		const vector<entity_template_entity_raw>& entities = entities_raw.entities;
+		const uint8*							  src_data = entities_raw.component_buffer.get_raw();
+
+		vector<uint32> root_of(count);
+		for (uint32 i = 0; i < count; i++)
+		{
+			uint32 r = i;
+			while (entities[r].parent != -1)
+				r = static_cast<uint32>(entities[r].parent);
+			root_of[i] = r;
+		}
+
+		// subtrees holding world-wide state, or referencing entities outside themselves, stay in the persistent template.
+		vector<uint8>			 persistent(count, 0);
+		vector<component_record> records;
+		{
+			istream			 in(entities_raw.component_buffer.get_raw(), entities_raw.component_buffer.get_size());
+			component_record rec = {};
+			while (entity_template_utils::scan_component_record(in, rec))
+			{
+				const uint32 root = root_of[rec.entity];
+				if (is_world_component(rec.comp_type))
+					persistent[root] = 1;
+
+				for (size_t off : rec.entity_ref_offsets)
+				{
+					const int32 ref = read_index(src_data + rec.begin + off);
+					if (ref == -1 || root_of[ref] == root)
+						continue;
+					persistent[root]		 = 1;
+					persistent[root_of[ref]] = 1;
+				}
+
+				records.push_back(rec);
+			}
+		}
+
+		// destination of each root, -1 is the persistent template, otherwise an index into out_templates.
+		const uint32			 template_base = static_cast<uint32>(out_templates.size());
+		const string			 base_path	   = world_path.substr(0, world_path.find_last_of("."));
+		hash_map<uint64, uint32> cell_by_key;
+		vector<int32>			 dest_of_root(count, -1);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const entity_template_entity_raw& e = entities[i];
+			if (e.parent != -1 || persistent[i])
+				continue;
+
+			const int32	 cx	 = static_cast<int32>(std::floor(e.position.x / cell_size));
+			const int32	 cz	 = static_cast<int32>(std::floor(e.position.z / cell_size));
+			const uint64 key = (static_cast<uint64>(static_cast<uint32>(cx)) << 32) | static_cast<uint64>(static_cast<uint32>(cz));
+
+			auto it = cell_by_key.find(key);
+			if (it != cell_by_key.end())
+			{
+				dest_of_root[i] = static_cast<int32>(it->second);
+				continue;
+			}
+
+			const uint32 index = template_base + static_cast<uint32>(cells.size());
+			cell_by_key[key]   = index;
+			dest_of_root[i]	   = static_cast<int32>(index);
+
+			cells.push_back({
+				.template_path = base_path + "_cell_" + std::to_string(cx) + "_" + std::to_string(cz) + ".stkent",
+				.x			   = cx,
+				.z			   = cz,
+			});
+
+			out_templates.push_back({});
+			out_templates.back().name = cells.back().template_path;
+		}
+
+		if (cells.empty())
+			return;
+
+		entity_template_raw persistent_raw = {};
+
+		auto target = [&](uint32 entity) -> entity_template_raw& {
+			const int32 dest = dest_of_root[root_of[entity]];
+			return dest == -1 ? persistent_raw : out_templates[dest];
+		};
+
+		// entity indices restart in every template, template order is kept so parents still precede children.
+		vector<int32> new_index(count, -1);
+		for (uint32 i = 0; i < count; i++)
+		{
+			entity_template_raw& t = target(i);
+			new_index[i]		   = static_cast<int32>(t.entities.size());
+			t.entities.push_back(entities[i]);
+		}
+
+		auto remap = [&](int32 from, uint32 owner) -> int32 {
+			if (from == -1 || dest_of_root[root_of[from]] != dest_of_root[root_of[owner]])
+				return -1;
+			return new_index[from];
+		};
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			entity_template_raw&		t = target(i);
+			entity_template_entity_raw& e = t.entities[new_index[i]];
+			e.parent					  = remap(e.parent, i);
+			e.first_child				  = remap(e.first_child, i);
+			e.next_sibling				  = remap(e.next_sibling, i);
+
+			if (!e.template_reference.empty())
+				push_unique(t.resources, e.template_reference);
+		}
+
+		for (const component_record& rec : records)
+		{
+			entity_template_raw& t	 = target(rec.entity);
+			ostream&			 out = t.component_buffer;
+			const size_t		 at	 = out.get_size();
+			out.write_raw(src_data + rec.begin, rec.end - rec.begin);
+
+			uint8* dst = out.get_raw() + at;
+			write_index(dst + sizeof(string_id), new_index[rec.entity]);
+			for (size_t off : rec.entity_ref_offsets)
+			{
+				const int32 ref = read_index(dst + off);
+				if (ref != -1)
+					write_index(dst + off, new_index[ref]);
+			}
+
+			for (const string& res : rec.resources)
+				push_unique(t.resources, res);
+		}
+
+		entities_raw.destroy();
+		entities_raw = persistent_raw;
+	}
+
 #endif
 }
@@ -39,6 +39,17 @@ namespace SFG
 	class istream;
 	class world;
 
+	struct world_cell_raw
+	{
+		string		   template_path = "";
+		vector<string> resources	 = {};
+		int32		   x			 = 0;
+		int32		   z			 = 0;
+
+		void serialize(ostream& stream) const;
+		void deserialize(istream& stream);
+	};
+
 	struct world_raw
 	{
 
@@ -52,11 +63,14 @@ namespace SFG
 		bool load_from_file(const char* relative_file, const char* base_path);
 		bool save_to_file(const char* file, world& w);
 		void fill_from_world(world& w);
+		void partition_cells(const string& world_path, vector<entity_template_raw>& out_templates);
 #endif
 
-		vector3				tool_cam_pos	= vector3::zero;
-		quat				tool_cam_rot	= quat::identity;
-		entity_template_raw entities_raw	= {};
-		vector<string>		extra_resources = {};
+		vector3				   tool_cam_pos	   = vector3::zero;
+		quat				   tool_cam_rot	   = quat::identity;
+		entity_template_raw	   entities_raw	   = {};
+		vector<string>		   extra_resources = {};
+		vector<world_cell_raw> cells		   = {};
+		float				   cell_size	   = 0.0f;
 	};
 }
@@ -28,76 +28,468 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "io/log.hpp"
 #include "data/istream.hpp"
 #include "data/ostream.hpp"
+#include "data/hash_map.hpp"
+#include "common/string_id.hpp"
+#include "math/math.hpp"
 #include <lz4/lz4.h>
+#include <algorithm>
 
 namespace SFG
 {
-	size_t estimate_decompressed_size(size_t compressedSize)
+	namespace
 	{
-		// return (compressedSize << 8) - compressedSize - 2526;
-		return 255 * compressedSize + 24;
+		constexpr uint32 frame_block_stored = 0x80000000u;
+		constexpr size_t frame_header_size	= sizeof(uint32) + sizeof(uint64) + sizeof(uint32);
+		constexpr size_t dict_segment		= 32;
+		constexpr size_t dict_stride		= 16;
+		constexpr size_t legacy_trailer		= sizeof(uint8) + sizeof(uint32);
+		constexpr size_t legacy_min_size	= 750000;
+		constexpr size_t legacy_max_size	= 150000000;
+
+		struct dict_candidate
+		{
+			const uint8* data		 = nullptr;
+			uint32		 samples	 = 0;
+			uint32		 last_sample = 0;
+		};
+
+		// high level encoder limits, see lz4 block format: matches are at least 4 bytes, reach back at most 64 kb,
+		// the last match starts 12 bytes before the end and the last 5 bytes are always literals.
+		constexpr uint32 hc_hash_log	  = 16;
+		constexpr uint32 hc_max_attempts  = 256;
+		constexpr uint32 hc_max_distance  = 65535;
+		constexpr uint32 hc_min_match	  = 4;
+		constexpr uint32 hc_last_literals = 5;
+		constexpr uint32 hc_match_limit	  = 12;
+
+		struct hc_state
+		{
+			vector<int64>  heads;
+			vector<uint16> chain;
+		};
+
+		inline uint32 hc_read32(const uint8* p)
+		{
+			uint32 v = 0;
+			SFG_MEMCPY(&v, p, sizeof(uint32));
+			return v;
+		}
+
+		inline uint32 hc_hash(const uint8* p)
+		{
+			return (hc_read32(p) * 2654435761u) >> (32 - hc_hash_log);
+		}
+
+		inline void hc_insert(hc_state& st, const uint8* base, int64 pos)
+		{
+			int64&		head  = st.heads[hc_hash(base + pos)];
+			const int64 delta = pos - head;
+			st.chain[static_cast<size_t>(pos) & 0xFFFF] = static_cast<uint16>(delta > hc_max_distance ? hc_max_distance : delta);
+			head = pos;
+		}
+
+		// longest match for pos among up to hc_max_attempts earlier positions with the same hash, 0 if none reaches hc_min_match.
+		uint32 hc_find(const hc_state& st, const uint8* base, int64 pos, int64 limit, int64& out_ref)
+		{
+			const int64	 lowest = pos > hc_max_distance ? pos - hc_max_distance : 0;
+			const uint32 head	= hc_read32(base + pos);
+			int64		 cand	= st.heads[hc_hash(base + pos)];
+			uint32		 best	= 0;
+
+			for (uint32 attempts = 0; attempts < hc_max_attempts && cand >= lowest && cand < pos; attempts++)
+			{
+				if (hc_read32(base + cand) == head)
+				{
+					int64 len = hc_min_match;
+					while (pos + len < limit && base[cand + len] == base[pos + len])
+						len++;
+
+					if (static_cast<uint32>(len) > best)
+					{
+						best	= static_cast<uint32>(len);
+						out_ref = cand;
+						if (pos + len >= limit)
+							break;
+					}
+				}
+
+				const uint16 delta = st.chain[static_cast<size_t>(cand) & 0xFFFF];
+				if (delta == 0 || delta == hc_max_distance)
+					break;
+				cand -= delta;
+			}
+
+			return best;
+		}
+
+		inline void hc_write_length(uint8*& op, size_t len)
+		{
+			while (len >= 255)
+			{
+				*op++ = 255;
+				len -= 255;
+			}
+			*op++ = static_cast<uint8>(len);
+		}
+
+		void hc_write_sequence(uint8*& op, const uint8* literals, size_t literal_len, uint32 offset, uint32 match_len)
+		{
+			uint8* token = op++;
+			*token		 = static_cast<uint8>((literal_len >= 15 ? 15 : literal_len) << 4);
+			if (literal_len >= 15)
+				hc_write_length(op, literal_len - 15);
+
+			SFG_MEMCPY(op, literals, literal_len);
+			op += literal_len;
+
+			// the closing sequence is literals only.
+			if (match_len == 0)
+				return;
+
+			*op++ = static_cast<uint8>(offset & 0xFF);
+			*op++ = static_cast<uint8>(offset >> 8);
+
+			const size_t ml = match_len - hc_min_match;
+			*token |= static_cast<uint8>(ml >= 15 ? 15 : ml);
+			if (ml >= 15)
+				hc_write_length(op, ml - 15);
+		}
+
+		/*
+		 * Hash chain encoder with one step lazy matching, writing plain lz4 blocks that decode with the regular lz4 decoders.
+		 * base holds prefix bytes of history followed by the size bytes to compress, matches may reach into the history
+		 * the same way lz4 dictionaries and frame blocks do. dst has to hold LZ4_compressBound(size) bytes.
+		 */
+		size_t compress_hc(const uint8* base, size_t prefix, size_t size, uint8* dst)
+		{
+			static thread_local hc_state st;
+			st.heads.assign(static_cast<size_t>(1) << hc_hash_log, -static_cast<int64>(hc_max_distance) - 1);
+			st.chain.resize(65536);
+
+			const int64 begin	  = static_cast<int64>(prefix);
+			const int64 end		  = begin + static_cast<int64>(size);
+			const int64 match_end = end - hc_last_literals;
+			const int64 last_pos  = end - hc_match_limit;
+
+			int64 history = begin > hc_max_distance ? begin - hc_max_distance : 0;
+			for (; history < begin && history + 4 <= end; history++)
+				hc_insert(st, base, history);
+
+			uint8* op	  = dst;
+			int64  anchor = begin;
+			int64  ip	  = begin;
+			int64  next	  = history;
+
+			while (ip <= last_pos)
+			{
+				for (; next < ip; next++)
+					hc_insert(st, base, next);
+
+				int64		ref = 0;
+				uint32		len = hc_find(st, base, ip, match_end, ref);
+				if (len < hc_min_match)
+				{
+					ip++;
+					continue;
+				}
+
+				// a longer match one byte later is worth the extra literal.
+				while (ip + 1 <= last_pos)
+				{
+					hc_insert(st, base, ip);
+					next = ip + 1;
+
+					int64		 lazy_ref = 0;
+					const uint32 lazy_len = hc_find(st, base, ip + 1, match_end, lazy_ref);
+					if (lazy_len <= len)
+						break;
+
+					ip++;
+					len = lazy_len;
+					ref = lazy_ref;
+				}
+
+				hc_write_sequence(op, base + anchor, static_cast<size_t>(ip - anchor), static_cast<uint32>(ip - ref), len);
+				ip += len;
+				anchor = ip;
+			}
+
+			hc_write_sequence(op, base + anchor, static_cast<size_t>(end - anchor), 0, 0);
+			return static_cast<size_t>(op - dst);
+		}
+	}
+
+	bool compressor::compress_block(const uint8* src, size_t size, vector<uint8>& out, const vector<uint8>* dictionary, compressor_level level)
+	{
+		if (size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+			return false;
+
+		const int bound = LZ4_compressBound(static_cast<int>(size));
+		out.resize(static_cast<size_t>(bound));
+
+		const bool has_dictionary = dictionary != nullptr && !dictionary->empty();
+
+		int written = 0;
+		if (level == compressor_level::high)
+		{
+			if (has_dictionary)
+			{
+				// the encoder needs history and input back to back, only the tail of the dictionary is reachable.
+				static thread_local vector<uint8> joined;
+				const size_t					  prefix = math::min(dictionary->size(), static_cast<size_t>(COMPRESSOR_DICT_SIZE));
+				joined.resize(prefix + size);
+				SFG_MEMCPY(joined.data(), dictionary->data() + dictionary->size() - prefix, prefix);
+				SFG_MEMCPY(joined.data() + prefix, src, size);
+				written = static_cast<int>(compress_hc(joined.data(), prefix, size, out.data()));
+			}
+			else
+				written = static_cast<int>(compress_hc(src, 0, size, out.data()));
+		}
+		else if (has_dictionary)
+		{
+			LZ4_stream_t lz;
+			LZ4_initStream(&lz, sizeof(lz));
+			LZ4_loadDict(&lz, reinterpret_cast<const char*>(dictionary->data()), static_cast<int>(dictionary->size()));
+			written = LZ4_compress_fast_continue(&lz, reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()), static_cast<int>(size), bound, 1);
+		}
+		else
+			written = LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()), static_cast<int>(size), bound);
+
+		if (written <= 0)
+		{
+			out.resize(0);
+			return false;
+		}
+
+		out.resize(static_cast<size_t>(written));
+		return true;
+	}
+
+	bool compressor::decompress_block(const uint8* src, size_t size, uint8* dst, size_t dst_size, const vector<uint8>* dictionary)
+	{
+		int read = 0;
+		if (dictionary != nullptr && !dictionary->empty())
+			read = LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), static_cast<int>(size), static_cast<int>(dst_size), reinterpret_cast<const char*>(dictionary->data()), static_cast<int>(dictionary->size()));
+		else
+			read = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), static_cast<int>(size), static_cast<int>(dst_size));
+
+		if (read != static_cast<int>(dst_size))
+		{
+			SFG_ERR("[compressor] -> LZ4 block decompression failed!");
+			return false;
+		}
+		return true;
+	}
+
+	bool compressor::compress_frame(const uint8* src, size_t size, ostream& out, compressor_level level)
+	{
+		out << static_cast<uint32>(COMPRESSOR_FRAME_MAGIC);
+		out << static_cast<uint64>(size);
+		out << static_cast<uint32>(COMPRESSOR_BLOCK_SIZE);
+
+		static thread_local vector<uint8> scratch;
+
+		const int bound = LZ4_compressBound(COMPRESSOR_BLOCK_SIZE);
+		scratch.resize(static_cast<size_t>(bound));
+
+		LZ4_stream_t lz;
+		LZ4_initStream(&lz, sizeof(lz));
+
+		for (size_t pos = 0; pos < size; pos += COMPRESSOR_BLOCK_SIZE)
+		{
+			const int	 block_size = static_cast<int>(math::min(static_cast<size_t>(COMPRESSOR_BLOCK_SIZE), size - pos));
+			const size_t dict_size	= math::min(pos, static_cast<size_t>(COMPRESSOR_DICT_SIZE));
+
+			// every block restarts from the tail of the previous one, so blocks decode on their own against the output written so far.
+			int written = 0;
+			if (level == compressor_level::high)
+				written = static_cast<int>(compress_hc(src + pos - dict_size, dict_size, static_cast<size_t>(block_size), scratch.data()));
+			else
+			{
+				LZ4_resetStream_fast(&lz);
+				if (dict_size != 0)
+					LZ4_loadDict(&lz, reinterpret_cast<const char*>(src + pos - dict_size), static_cast<int>(dict_size));
+
+				written = LZ4_compress_fast_continue(&lz, reinterpret_cast<const char*>(src + pos), reinterpret_cast<char*>(scratch.data()), block_size, bound, 1);
+			}
+
+			if (written <= 0 || written >= block_size)
+			{
+				out << (static_cast<uint32>(block_size) | frame_block_stored);
+				out.write_raw(src + pos, static_cast<size_t>(block_size));
+				continue;
+			}
+
+			out << static_cast<uint32>(written);
+			out.write_raw(scratch.data(), static_cast<size_t>(written));
+		}
+
+		return true;
+	}
+
+	uint64 compressor::get_frame_size(const uint8* src, size_t size)
+	{
+		if (size < frame_header_size)
+			return 0;
+
+		istream in(const_cast<uint8*>(src), size);
+		uint32	magic	   = 0;
+		uint64	total	   = 0;
+		uint32	block_size = 0;
+		in >> magic;
+		in >> total;
+		in >> block_size;
+
+		if (magic != COMPRESSOR_FRAME_MAGIC || block_size == 0 || block_size > static_cast<uint32>(LZ4_MAX_INPUT_SIZE))
+			return 0;
+
+		return total;
 	}
 
-	ostream compressor::compress(ostream& stream)
+	uint64 compressor::get_legacy_size(const uint8* src, size_t size)
 	{
-		const uint32 streamSize		  = static_cast<uint32>(stream.get_size());
-		const uint8	 shouldCompress	  = (streamSize < 150000000 && streamSize > 750000) ? 1 : 0;
-		const uint32 uncompressedSize = streamSize + sizeof(uint8) + sizeof(uint32);
+		if (size < legacy_trailer)
+			return 0;
 
-		stream << shouldCompress;
-		stream << uncompressedSize;
+		istream in(const_cast<uint8*>(src), size);
+		uint8	compressed		  = 0;
+		uint32	uncompressed_size = 0;
+		in.seek(size - legacy_trailer);
+		in >> compressed;
+		in >> uncompressed_size;
 
-		if (!shouldCompress)
+		// stored files: the trailer size is the file size.
+		if (compressed == 0)
+			return uncompressed_size == size ? static_cast<uint64>(size - legacy_trailer) : 0;
+
+		// compressed files: the whole file is one block, sized within the old limits.
+		const size_t payload = static_cast<size_t>(uncompressed_size) - legacy_trailer;
+		if (compressed != 1 || uncompressed_size < legacy_trailer || payload <= legacy_min_size || payload >= legacy_max_size)
+			return 0;
+
+		return static_cast<uint64>(payload);
+	}
+
+	bool compressor::decompress_legacy(const uint8* src, size_t size, uint8* dst, size_t dst_size)
+	{
+		const uint64 payload = get_legacy_size(src, size);
+		if (payload == 0 || payload != static_cast<uint64>(dst_size))
+			return false;
+
+		istream in(const_cast<uint8*>(src), size);
+		uint8	compressed = 0;
+		in.seek(size - legacy_trailer);
+		in >> compressed;
+
+		if (compressed == 0)
 		{
-			ostream compressed;
-			compressed.create(stream.get_size());
-			compressed.write_raw(stream.get_raw(), stream.get_size());
-			return compressed;
+			SFG_MEMCPY(dst, src, dst_size);
+			return true;
 		}
 
-		const int size			= static_cast<int>(stream.get_size());
-		const int compressBound = LZ4_compressBound(size);
+		// the block was compressed with the trailer appended, decoding stops right before it.
+		const int written = LZ4_decompress_safe_partial(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), static_cast<int>(size), static_cast<int>(dst_size), static_cast<int>(dst_size));
+		return written == static_cast<int>(dst_size);
+	}
+
+	bool compressor::decompress_frame(const uint8* src, size_t size, uint8* dst, size_t dst_size)
+	{
+		const uint64 total = get_frame_size(src, size);
+		if (total != static_cast<uint64>(dst_size))
+		{
+			SFG_ERR("[compressor] -> LZ4 frame size mismatch!");
+			return false;
+		}
+
+		istream in(const_cast<uint8*>(src), size);
+		uint32	block_size = 0;
+		in.skip_by(frame_header_size - sizeof(uint32));
+		in >> block_size;
+
+		size_t pos = 0;
+		while (pos < dst_size)
+		{
+			if (in.tellg() + sizeof(uint32) > size)
+				break;
+
+			uint32 word = 0;
+			in >> word;
+
+			const bool	 stored	   = (word & frame_block_stored) != 0;
+			const size_t stored_sz = static_cast<size_t>(word & ~frame_block_stored);
+			const size_t expected  = math::min(static_cast<size_t>(block_size), dst_size - pos);
+			if (in.tellg() + stored_sz > size)
+				break;
+
+			const uint8* block = in.get_data_current();
 
-		// Create stream capable of holding max compressed bytes.
-		ostream compressedStream = ostream();
-		compressedStream.create(compressBound);
-		char* dest		   = (char*)compressedStream.get_raw();
-		char* data		   = (char*)stream.get_raw();
-		int	  bytesWritten = LZ4_compress_default(data, dest, size, compressBound);
+			if (stored)
+			{
+				if (stored_sz != expected)
+					break;
+				SFG_MEMCPY(dst + pos, block, expected);
+			}
+			else
+			{
+				const size_t dict_size = math::min(pos, static_cast<size_t>(COMPRESSOR_DICT_SIZE));
+				const int	 read	   = LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(block), reinterpret_cast<char*>(dst + pos), static_cast<int>(stored_sz), static_cast<int>(expected), reinterpret_cast<const char*>(dst + pos - dict_size), static_cast<int>(dict_size));
+				if (read != static_cast<int>(expected))
+					break;
+			}
 
-		if (bytesWritten == 0)
+			in.skip_by(stored_sz);
+			pos += expected;
+		}
+
+		if (pos != dst_size)
 		{
-			SFG_ERR("[compressor] -> LZ4 compression failed!");
+			SFG_ERR("[compressor] -> LZ4 frame decompression failed!");
+			return false;
 		}
 
-		compressedStream.shrink(static_cast<size_t>(bytesWritten));
-		return compressedStream;
+		return true;
 	}
 
-	istream compressor::decompress(istream& stream)
+	void compressor::build_dictionary(const vector<span<const uint8>>& samples, vector<uint8>& out)
 	{
-		// Read uncompressed size of archive.
-		uint8  shouldDecompress = 0;
-		uint32 uncompressedSize = 0;
-		stream.seek(stream.get_size() - sizeof(uint32) - sizeof(uint8));
-		stream.read(shouldDecompress);
-		stream.read(uncompressedSize);
-		stream.seek(0);
-
-		if (!shouldDecompress)
-		{
-			istream copy;
-			copy.create(stream.get_raw(), stream.get_size() - sizeof(uint32) - sizeof(uint8));
-			return copy;
-		}
-
-		const size_t size				= stream.get_size();
-		istream		 decompressedStream = istream();
-		decompressedStream.create(nullptr, uncompressedSize);
-		void*	  src			   = stream.get_raw();
-		void*	  ptr			   = decompressedStream.get_raw();
-		const int decompressedSize = LZ4_decompress_safe((char*)src, (char*)ptr, static_cast<int>(size), static_cast<int>(uncompressedSize));
-		decompressedStream.shrink(static_cast<size_t>(decompressedSize) - sizeof(uint32) - sizeof(uint8));
-		return decompressedStream;
+		out.resize(0);
+
+		// fixed size segments at a fixed stride, counted once per sample they appear in.
+		hash_map<string_id, uint32> index;
+		vector<dict_candidate>		candidates;
+
+		const uint32 samples_count = static_cast<uint32>(samples.size());
+		for (uint32 i = 0; i < samples_count; i++)
+		{
+			const span<const uint8>& sample = samples[i];
+			for (size_t off = 0; off + dict_segment <= sample.size; off += dict_stride)
+			{
+				const uint8*	data = sample.data + off;
+				const string_id h	 = hash_bytes(reinterpret_cast<const char*>(data), dict_segment);
+				auto			it	 = index.find(h);
+				if (it == index.end())
+				{
+					index[h] = static_cast<uint32>(candidates.size());
+					candidates.push_back({.data = data, .samples = 1, .last_sample = i});
+					continue;
+				}
+
+				dict_candidate& c = candidates[it->second];
+				if (c.last_sample == i)
+					continue;
+				c.samples++;
+				c.last_sample = i;
+			}
+		}
+
+		std::stable_sort(candidates.begin(), candidates.end(), [](const dict_candidate& a, const dict_candidate& b) -> bool { return a.samples > b.samples; });
+
+		size_t picked = 0;
+		while (picked < candidates.size() && candidates[picked].samples > 1 && (picked + 1) * dict_segment <= COMPRESSOR_DICT_SIZE)
+			picked++;
+
+		out.resize(picked * dict_segment);
+		for (size_t i = 0; i < picked; i++)
+			SFG_MEMCPY(out.data() + (picked - 1 - i) * dict_segment, candidates[i].data, dict_segment);
 	}
 }
@@ -26,15 +26,49 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include "common/size_definitions.hpp"
+#include "data/vector.hpp"
+#include "data/span.hpp"
+
 namespace SFG
 {
 	class ostream;
 	class istream;
 
+#define COMPRESSOR_FRAME_MAGIC 0x5A4C4653 // SFLZ
+#define COMPRESSOR_BLOCK_SIZE  1048576
+#define COMPRESSOR_DICT_SIZE   65536
+#define COMPRESSOR_MIN_SIZE	   4096
+
+	enum class compressor_level : uint8
+	{
+		fast,
+		high,
+	};
+
+	/*
+	 * LZ4 codecs.
+	 * Blocks are single shot with int sizes, optionally primed with a dictionary, meant for package entries.
+	 * Frames split any size into COMPRESSOR_BLOCK_SIZE blocks, each primed with the previous 64 kb of input so the ratio stays close to a single block,
+	 * memory per call is bounded by one block and sizes are 64 bit. Incompressible blocks are stored as is.
+	 * All decompression writes into caller provided buffers.
+	 * The high level trades encode speed for ratio with a deeper match search, its output is regular lz4 and decodes at the same speed.
+	 */
 	class compressor
 	{
 	public:
-		static ostream compress(ostream& stream);
-		static istream decompress(istream& stream);
+		static bool compress_block(const uint8* src, size_t size, vector<uint8>& out, const vector<uint8>* dictionary = nullptr, compressor_level level = compressor_level::fast);
+		static bool decompress_block(const uint8* src, size_t size, uint8* dst, size_t dst_size, const vector<uint8>* dictionary = nullptr);
+
+		static bool	  compress_frame(const uint8* src, size_t size, ostream& out, compressor_level level = compressor_level::fast);
+		static bool	  decompress_frame(const uint8* src, size_t size, uint8* dst, size_t dst_size);
+		static uint64 get_frame_size(const uint8* src, size_t size);
+
+		// files written before frames end with a stored flag and the uncompressed size (trailer included), payloads between the old limits are one lz4 block.
+		static uint64 get_legacy_size(const uint8* src, size_t size);
+		static bool	  decompress_legacy(const uint8* src, size_t size, uint8* dst, size_t dst_size);
+
+		// picks the byte runs shared by most samples, most common last so they sit closest to the data being compressed.
+		static void build_dictionary(const vector<span<const uint8>>& samples, vector<uint8>& out);
 	};
 };
@@ -54,7 +54,7 @@ namespace SFG
 		return true;
 	}
 
-	bool serialization::save_to_file(const char* path, ostream& stream)
+	bool serialization::save_to_file(const char* path, ostream& stream, bool allow_compression)
 	{
 		if (file_system::exists(path))
 			file_system::delete_file(path);
@@ -67,10 +67,21 @@ namespace SFG
 			return false;
 		}
 
-		ostream compressed = compressor::compress(stream);
-		compressed.write_to_ofstream(wf);
+		// small or opted out files are written as is, load_from_file tells them apart by the frame magic.
+		// raw files that happen to start like a frame or end like a pre-frame trailer are always framed, so they are never mistaken for one.
+		const bool lookalike = compressor::get_frame_size(stream.get_raw(), stream.get_size()) != 0 || compressor::get_legacy_size(stream.get_raw(), stream.get_size()) != 0;
+		if (lookalike || (allow_compression && stream.get_size() >= COMPRESSOR_MIN_SIZE))
+		{
+			ostream compressed;
+			compressed.create(stream.get_size() / 2 + 64);
+			compressor::compress_frame(stream.get_raw(), stream.get_size(), compressed);
+			compressed.write_to_ofstream(wf);
+			compressed.destroy();
+		}
+		else
+			stream.write_to_ofstream(wf);
+
 		wf.close();
-		compressed.destroy();
 
 		if (!wf.good())
 		{
@@ -112,8 +123,40 @@ namespace SFG
 			return {};
 		}
 
-		istream decompressedStream = compressor::decompress(readStream);
+		const uint64 frame_size = compressor::get_frame_size(readStream.get_raw(), readStream.get_size());
+		if (frame_size == 0)
+		{
+			const uint64 legacy_size = compressor::get_legacy_size(readStream.get_raw(), readStream.get_size());
+			if (legacy_size == 0)
+				return readStream;
+
+			istream legacyStream;
+			legacyStream.create(nullptr, static_cast<size_t>(legacy_size));
+			const bool legacy_ok = compressor::decompress_legacy(readStream.get_raw(), readStream.get_size(), legacyStream.get_raw(), static_cast<size_t>(legacy_size));
+			readStream.destroy();
+
+			if (!legacy_ok)
+			{
+				SFG_ERR("[Serialization] -> Failed decompressing the legacy file! {0}", path);
+				legacyStream.destroy();
+				return {};
+			}
+
+			return legacyStream;
+		}
+
+		istream decompressedStream;
+		decompressedStream.create(nullptr, static_cast<size_t>(frame_size));
+		const bool ok = compressor::decompress_frame(readStream.get_raw(), readStream.get_size(), decompressedStream.get_raw(), static_cast<size_t>(frame_size));
 		readStream.destroy();
+
+		if (!ok)
+		{
+			SFG_ERR("[Serialization] -> Failed decompressing the file! {0}", path);
+			decompressedStream.destroy();
+			return {};
+		}
+
 		return decompressedStream;
 	}
 
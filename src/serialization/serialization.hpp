@@ -37,7 +37,7 @@ namespace SFG
 	{
 	public:
 		static bool	   write_to_file(string_view fileInput, const char* targetFilePath);
-		static bool	   save_to_file(const char* path, ostream& stream);
+		static bool	   save_to_file(const char* path, ostream& stream, bool allow_compression = true);
 		static istream load_from_file(const char* path);
 	};
 
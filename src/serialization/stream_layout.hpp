@@ -0,0 +1,51 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <type_traits>
+
+namespace SFG
+{
+	/*
+	 * Marks types whose in-memory layout is identical to what their serialize() writes on a little endian host:
+	 * fields in declaration order, no padding, each field streamed as raw arithmetic.
+	 * vectors of such types are streamed as one block instead of element by element.
+	 * arithmetic types are implicitly raw, bool is excluded since std::vector<bool> has no contiguous storage.
+	 */
+	template <typename T> struct stream_layout_raw : std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>
+	{
+	};
+
+	template <typename T> inline constexpr bool stream_layout_raw_v = stream_layout_raw<T>::value && std::is_trivially_copyable_v<T>;
+
+	// use inside namespace SFG right after the type, SIZE is the byte size serialize() writes.
+#define SFG_STREAM_LAYOUT_RAW(T, SIZE)                                                                                                                                                                                                                            \
+	static_assert(sizeof(T) == SIZE, #T " has padding or a layout different than its serialized form.");                                                                                                                                                          \
+	template <> struct stream_layout_raw<T> : std::true_type                                                                                                                                                                                                      \
+	{                                                                                                                                                                                                                                                             \
+	}
+}
@@ -0,0 +1,183 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// Headless entity template tests: spawns a template through its compiled plan and through the raw path and compares
+// the results, then reloads a referenced resource and checks the already compiled plan resolves the new handle.
+// usage: StakeforgeEntityTemplateTests, returns non-zero on failure.
+
+#include "tests/test_common.hpp"
+#include "world/world.hpp"
+#include "world/components/comp_camera.hpp"
+#include "world/components/comp_animation_controller.hpp"
+#include "resources/entity_template.hpp"
+#include "resources/res_state_machine.hpp"
+#include "reflection/reflection.hpp"
+#include "io/log.hpp"
+#include "math/math.hpp"
+
+namespace SFG
+{
+	namespace
+	{
+		constexpr const char* TEST_TEMPLATE = "tests/spawn_test.stkent";
+		constexpr const char* TEST_MACHINE	= "tests/spawn_test.stkanim";
+		constexpr const char* TEST_FILLER	= "tests/filler.stkanim";
+
+		test_suite s_suite = {.name = "entity template"};
+
+		template <typename T> T* find_field(world& w, string_id comp_type, world_handle entity, string_id field_sid)
+		{
+			const world_handle comp_handle = w.get_entity_manager().get_entity_component(comp_type, entity);
+			if (comp_handle.is_null())
+				return nullptr;
+
+			void* comp_ptr = w.get_comp_manager().get_component(comp_type, comp_handle);
+			for (field_base* f : reflection::get().resolve(comp_type).get_fields())
+			{
+				if (f->_sid == field_sid)
+					return f->value(comp_ptr).cast_ptr<T>();
+			}
+			return nullptr;
+		}
+
+		// root with a child, the child carries a camera and an animation controller pointing at the machine and both entities.
+		void build_template_raw(entity_template_raw& raw)
+		{
+			raw.name = TEST_TEMPLATE;
+			raw.entities.resize(2);
+			raw.entities[0].name		= "root";
+			raw.entities[0].first_child = 1;
+			raw.entities[1].name		= "child";
+			raw.entities[1].tag			= "spawned";
+			raw.entities[1].parent		= 0;
+			raw.entities[1].position	= vector3(1.0f, 2.0f, 3.0f);
+
+			ostream& out = raw.component_buffer;
+
+			out << type_id<comp_camera>::value;
+			out << static_cast<uint32>(1);
+			out << static_cast<uint32>(3);
+			out << "near"_hs << reflected_field_type::rf_float << 0.5f;
+			out << "fov_degrees"_hs << reflected_field_type::rf_float << 75.0f;
+			out << "removed_field"_hs << reflected_field_type::rf_string << string("skipped");
+
+			out << type_id<comp_animation_controller>::value;
+			out << static_cast<uint32>(1);
+			out << static_cast<uint32>(2);
+			out << "machine"_hs << reflected_field_type::rf_resource << type_id<res_state_machine>::value << static_cast<uint32>(1) << string(TEST_MACHINE);
+			out << "skin_entities"_hs << reflected_field_type::rf_entity << static_cast<uint32>(2) << static_cast<int32>(0) << static_cast<int32>(1);
+		}
+
+		resource_handle add_machine(world& w, const char* path)
+		{
+			resource_manager&	  rm  = w.get_resource_manager();
+			const resource_handle h	  = rm.add_resource<res_state_machine>(TO_SID(path));
+			res_state_machine_raw raw = {};
+			rm.get_resource<res_state_machine>(h).create_from_loader(raw, w, h);
+			return h;
+		}
+
+		void check_instance(world& w, world_handle root, resource_handle machine, const char* path_name)
+		{
+			entity_manager& em = w.get_entity_manager();
+
+			s_suite.check(!root.is_null(), path_name);
+			if (root.is_null())
+				return;
+
+			const world_handle child = em.get_entity_family(root).first_child;
+			s_suite.check(!child.is_null(), "child entity missing");
+			if (child.is_null())
+				return;
+
+			s_suite.check(string(em.get_entity_meta(root).name) == "root", "root name");
+			s_suite.check(string(em.get_entity_meta(child).tag) == "spawned", "child tag");
+			s_suite.check(em.get_entity_position(child) == vector3(1.0f, 2.0f, 3.0f), "child position");
+
+			const float* near_plane = find_field<float>(w, type_id<comp_camera>::value, child, "near"_hs);
+			const float* fov		= find_field<float>(w, type_id<comp_camera>::value, child, "fov_degrees"_hs);
+			s_suite.check(near_plane && math::almost_equal(*near_plane, 0.5f), "camera near");
+			s_suite.check(fov && math::almost_equal(*fov, 75.0f), "camera fov");
+
+			const resource_handle*		machine_field = find_field<resource_handle>(w, type_id<comp_animation_controller>::value, child, "machine"_hs);
+			const vector<world_handle>* skin_field	  = find_field<vector<world_handle>>(w, type_id<comp_animation_controller>::value, child, "skin_entities"_hs);
+			s_suite.check(machine_field && *machine_field == machine, "machine resolves to the loaded handle");
+			s_suite.check(skin_field && skin_field->size() == 2 && (*skin_field)[0] == root && (*skin_field)[1] == child, "skin entities point into the same instance");
+		}
+
+		int run()
+		{
+			headless_world headless;
+			headless.init();
+			world* w = headless.w;
+
+			resource_manager& rm = w->get_resource_manager();
+			entity_manager&	  em = w->get_entity_manager();
+
+			const resource_handle machine = add_machine(*w, TEST_MACHINE);
+
+			entity_template_raw raw = {};
+			build_template_raw(raw);
+
+			// the template owns the component buffer from here on and frees it on destroy.
+			const resource_handle templ = rm.add_resource<entity_template>(TO_SID(TEST_TEMPLATE));
+			entity_template&	  et	= rm.get_resource<entity_template>(templ);
+			et.create_from_loader(raw, *w, templ);
+
+			const world_handle raw_root = em.instantiate_template(raw);
+			check_instance(*w, raw_root, machine, "raw instantiation");
+
+			const world_handle plan_root = em.instantiate_template(templ);
+			s_suite.check(et.get_plan().is_compiled() && et.get_plan().is_supported(), "instantiation goes through the plan");
+			s_suite.check(em.get_entity_template_ref(plan_root) == templ, "root references its template");
+			check_instance(*w, plan_root, machine, "plan instantiation");
+
+			world_handle batch[4] = {};
+			em.spawn_template(templ, 4, nullptr, batch);
+			for (world_handle root : batch)
+				check_instance(*w, root, machine, "batch spawn");
+
+			// reload the machine into a different slot, the compiled plan has to pick up the new handle.
+			rm.unload_resource(type_id<res_state_machine>::value, TO_SID(TEST_MACHINE));
+			add_machine(*w, TEST_FILLER);
+			const resource_handle reloaded = add_machine(*w, TEST_MACHINE);
+			s_suite.check(!(reloaded == machine), "reloaded machine lives in a new handle");
+
+			const world_handle reloaded_root = em.instantiate_template(templ);
+			check_instance(*w, reloaded_root, reloaded, "spawn after reload");
+
+			headless.uninit();
+
+			return s_suite.finish();
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	return SFG::test_main(SFG::run);
+}
@@ -0,0 +1,96 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "world/world.hpp"
+#include "gfx/event_stream/render_event_stream.hpp"
+#include "platform/process.hpp"
+#include "platform/time.hpp"
+#include "io/log.hpp"
+
+namespace SFG
+{
+	/*
+	 * Scaffolding shared by the headless test executables.
+	 * A suite counts failed checks and turns them into the exit code, test_main wraps a run function in platform init.
+	 */
+	struct test_suite
+	{
+		const char* name	 = "";
+		uint32		failures = 0;
+
+		void check(bool condition, const char* what)
+		{
+			if (condition)
+				return;
+
+			SFG_ERR("{0} test failed: {1}", name, what);
+			failures++;
+		}
+
+		int finish() const
+		{
+			if (failures == 0)
+				SFG_INFO("{0} tests passed.", name);
+			return failures == 0 ? 0 : 1;
+		}
+	};
+
+	// gpu-side default resources are skipped, nothing the tests touch needs a backend.
+	struct headless_world
+	{
+		render_event_stream stream;
+		world*				w = nullptr;
+
+		void init()
+		{
+			stream.init();
+			w = new world(stream);
+			w->init_preserve_resources();
+		}
+
+		void uninit()
+		{
+			w->uninit();
+			delete w;
+			w = nullptr;
+			stream.uninit();
+		}
+	};
+
+	inline int test_main(int (*run)())
+	{
+		process::init();
+		time::init();
+
+		const int result = run();
+
+		time::uninit();
+		process::uninit();
+		return result;
+	}
+}
@@ -0,0 +1,182 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// Headless world cell streamer tests: streams two cells sharing a resource out of a temporary package and moves the focus
+// so one cell unloads while the other is still loading, the shared resource has to survive. Also checks a resource loaded
+// outside the streamer is never unloaded by it.
+// usage: StakeforgeWorldCellStreamerTests, returns non-zero on failure.
+
+#include "tests/test_common.hpp"
+#include "world/world.hpp"
+#include "resources/world_raw.hpp"
+#include "resources/entity_template_raw.hpp"
+#include "resources/res_state_machine.hpp"
+#include "resources/res_state_machine_raw.hpp"
+#include "app/package.hpp"
+#include "io/file_system.hpp"
+#include "io/log.hpp"
+
+namespace SFG
+{
+	namespace
+	{
+		constexpr const char* TEST_PACKAGE = "world_cell_streamer_test.stkpkg";
+		constexpr const char* TEST_SHARED  = "tests/cells_shared.stkanim";
+		constexpr const char* TEST_CELL_A  = "tests/cells_a.stkent";
+		constexpr const char* TEST_CELL_B  = "tests/cells_b.stkent";
+		constexpr float		  TEST_CELL	   = 10.0f;
+		constexpr uint32	  TEST_PUMPS   = 5000;
+
+		test_suite s_suite = {.name = "world cell streamer"};
+
+		void write_cell(package& pkg, const char* path, const char* entity_name)
+		{
+			entity_template_raw raw = {};
+			raw.name				= path;
+			raw.resources			= {TEST_SHARED};
+			raw.entities.resize(1);
+			raw.entities[0].name = entity_name;
+
+			pkg.write_resource(path);
+			raw.serialize(pkg.get_write_stream());
+			raw.destroy();
+		}
+
+		void write_package(const string& path)
+		{
+			package pkg = {};
+			pkg.start_writing();
+
+			res_state_machine_raw shared = {};
+			pkg.write_resource(TEST_SHARED);
+			shared.serialize(pkg.get_write_stream());
+
+			write_cell(pkg, TEST_CELL_A, "cell_a");
+			write_cell(pkg, TEST_CELL_B, "cell_b");
+			pkg.close_writing(path.c_str());
+		}
+
+		resource_handle shared_handle(world& w)
+		{
+			return w.get_resource_manager().get_resource_handle_by_hash_if_exists<res_state_machine>(TO_SID(TEST_SHARED));
+		}
+
+		// drives the streamers the way world::tick does until the named cell entity shows up.
+		bool pump_until_loaded(world& w, const char* entity_name)
+		{
+			for (uint32 i = 0; i < TEST_PUMPS; i++)
+			{
+				w.get_resource_streamer().tick();
+				w.get_cell_streamer().tick();
+				if (!w.get_entity_manager().find_entity(entity_name).is_null())
+					return true;
+				time::go_to_sleep(1);
+			}
+			return false;
+		}
+
+		void move_focus(world& w, world_handle focus, float x)
+		{
+			w.get_entity_manager().set_entity_position(focus, vector3(x, 0.0f, TEST_CELL * 0.5f));
+			w.get_resource_streamer().tick();
+			w.get_cell_streamer().tick();
+		}
+
+		int run()
+		{
+			const string package_path = file_system::get_running_directory() + TEST_PACKAGE;
+			write_package(package_path);
+
+			package pkg = {};
+			if (!pkg.open(package_path.c_str()))
+			{
+				SFG_ERR("failed opening test package: {0}", package_path);
+				return 1;
+			}
+
+			headless_world headless;
+			headless.init();
+			world* w = headless.w;
+			w->get_resource_streamer().init(pkg);
+
+			world_raw raw = {};
+			raw.cell_size = TEST_CELL;
+			raw.cells	  = {
+				{.template_path = TEST_CELL_A, .resources = {TEST_SHARED}, .x = 0, .z = 0},
+				{.template_path = TEST_CELL_B, .resources = {TEST_SHARED}, .x = 3, .z = 0},
+			};
+
+			world_cell_streamer& cells = w->get_cell_streamer();
+			cells.init(raw);
+			cells.set_budget(1000.0f);
+
+			entity_manager&	   em	 = w->get_entity_manager();
+			const world_handle focus = em.create_entity("focus");
+			cells.add_focus(focus);
+
+			// a is in range, b three cells away is not.
+			move_focus(*w, focus, TEST_CELL * 0.5f);
+			s_suite.check(pump_until_loaded(*w, "cell_a"), "cell a loads");
+			const resource_handle shared = shared_handle(*w);
+			s_suite.check(!shared.is_null(), "shared resource resident with cell a");
+
+			// a unloads in the same tick b is requested, b already references the shared resource.
+			move_focus(*w, focus, TEST_CELL * 3.5f);
+			s_suite.check(em.find_entity("cell_a").is_null(), "cell a unloaded");
+			s_suite.check(shared_handle(*w) == shared, "shared resource survives a neighbour unloading while b is loading");
+			s_suite.check(pump_until_loaded(*w, "cell_b"), "cell b loads");
+			s_suite.check(shared_handle(*w) == shared, "shared resource unchanged once b is loaded");
+
+			// nothing in range, the last reference goes and the streamer unloads what it loaded.
+			move_focus(*w, focus, TEST_CELL * 100.0f);
+			s_suite.check(em.find_entity("cell_b").is_null(), "cell b unloaded");
+			s_suite.check(shared_handle(*w).is_null(), "shared resource unloaded with its last cell");
+
+			// loaded by someone else first, the streamer references it but never unloads it.
+			resource_manager&	  rm		= w->get_resource_manager();
+			const resource_handle external	= rm.add_resource<res_state_machine>(TO_SID(TEST_SHARED));
+			res_state_machine_raw sm_raw	= {};
+			rm.get_resource<res_state_machine>(external).create_from_loader(sm_raw, *w, external);
+
+			move_focus(*w, focus, TEST_CELL * 0.5f);
+			s_suite.check(pump_until_loaded(*w, "cell_a"), "cell a reloads");
+			move_focus(*w, focus, TEST_CELL * 100.0f);
+			s_suite.check(shared_handle(*w) == external, "externally loaded resource stays resident");
+
+			headless.uninit();
+			pkg.close();
+			file_system::delete_file(package_path.c_str());
+
+			return s_suite.finish();
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	return SFG::test_main(SFG::run);
+}
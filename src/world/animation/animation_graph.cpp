@@ -34,6 +34,15 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "resources/res_state_machine_raw.hpp"
 #include <tracy/Tracy.hpp>
 
+#ifdef SFG_ENABLE_ANIMATION_STATS
+#include "platform/time.hpp"
+#define ANIM_STATS_BEGIN()	   const int64 stats_begin = time::get_cpu_cycles()
+#define ANIM_STATS_END(MEMBER) _stats.MEMBER += time::get_cpu_cycles() - stats_begin
+#else
+#define ANIM_STATS_BEGIN()
+#define ANIM_STATS_END(MEMBER)
+#endif
+
 namespace SFG
 {
 	animation_graph::animation_graph()
@@ -90,6 +99,10 @@ namespace SFG
 
 		entity_manager& em = w.get_entity_manager();
 
+#ifdef SFG_ENABLE_ANIMATION_STATS
+		_stats = {};
+#endif
+
 		const world_handle camera_entity = em.get_main_camera_entity();
 		const world_handle camera_comp	 = em.get_main_camera_comp();
 
@@ -123,7 +136,12 @@ namespace SFG
 			final_pose.reset();
 
 			if (!skip_pose)
+			{
 				calculate_pose_for_state(w, samples, final_pose, state);
+#ifdef SFG_ENABLE_ANIMATION_STATS
+				_stats.posed_machines++;
+#endif
+			}
 
 			progress_state(state, dt * state.speed);
 
@@ -181,7 +199,13 @@ namespace SFG
 			if (!skip_pose)
 			{
 				calculate_pose_for_state(w, samples, transition_blend_pose, target_state);
-				final_pose.blend_from(transition_blend_pose, ratio);
+
+				{
+					ANIM_STATS_BEGIN();
+					final_pose.blend_from(transition_blend_pose, ratio);
+					ANIM_STATS_END(blend_cycles);
+				}
+
 				apply_pose(w, m, final_pose);
 			}
 
@@ -629,6 +653,8 @@ namespace SFG
 		if (m.joint_entities.size == 0)
 			return;
 
+		ANIM_STATS_BEGIN();
+
 		world_handle* entity_handles = aux.get<world_handle>(m.joint_entities);
 
 		const uint16	  count = pose.get_joint_count();
@@ -653,6 +679,8 @@ namespace SFG
 			if (jp.flags.is_set(joint_pose_flags::has_scale))
 				em.set_entity_scale(entity, jp.scale);
 		}
+
+		ANIM_STATS_END(apply_cycles);
 	}
 
 	void animation_graph::calculate_pose_for_state(world& w, const state_samples_type& samples, animation_pose& out_pose, const animation_state& state)
@@ -699,8 +727,12 @@ namespace SFG
 
 			const resource_handle anim_handle = state_animations[i];
 
-			pose_i.reset();
-			pose_i.sample_from_animation(w, anim_handle, state._current_time, mask);
+			{
+				ANIM_STATS_BEGIN();
+				pose_i.reset();
+				pose_i.sample_from_animation(w, anim_handle, state._current_time, mask);
+				ANIM_STATS_END(sample_cycles);
+			}
 
 			if (!init)
 			{
@@ -710,9 +742,11 @@ namespace SFG
 			}
 			else
 			{
+				ANIM_STATS_BEGIN();
 				const float t = wi / (total_w + wi);
 				out_pose.blend_from(pose_i, t);
 				total_w += wi;
+				ANIM_STATS_END(blend_cycles);
 			}
 		}
 	}
@@ -45,6 +45,16 @@ namespace SFG
 		float		  value		  = 0.0f;
 	};
 
+#ifdef SFG_ENABLE_ANIMATION_STATS
+	struct animation_graph_stats
+	{
+		int64  sample_cycles  = 0;
+		int64  blend_cycles	  = 0;
+		int64  apply_cycles	  = 0;
+		uint32 posed_machines = 0;
+	};
+#endif
+
 	struct animation_pose;
 	class world;
 	class res_state_machine_raw;
@@ -109,6 +119,14 @@ namespace SFG
 			_throttle_max_frames   = max_frames;
 		}
 
+#ifdef SFG_ENABLE_ANIMATION_STATS
+		// stage timings of the last tick, in cpu cycles.
+		inline const animation_graph_stats& get_stats() const
+		{
+			return _stats;
+		}
+#endif
+
 	private:
 		// -----------------------------------------------------------------------------
 		// machine
@@ -150,5 +168,9 @@ namespace SFG
 
 		float _throttle_distance_sqr = 3000.0f;
 		uint8 _throttle_max_frames	 = 4;
+
+#ifdef SFG_ENABLE_ANIMATION_STATS
+		animation_graph_stats _stats = {};
+#endif
 	};
 }
@@ -111,16 +111,16 @@ namespace SFG
 		rebuild(w);
 	}
 
-	void comp_character_controller::update(world& w, float dt)
+	bool comp_character_controller::prepare_update(world& w, float dt)
 	{
 		if (_controller == nullptr)
 			create_controller(w);
-		if (_controller == nullptr)
-			return;
 
-		if (dt <= 0.0f)
-			return;
+		return _controller != nullptr && dt > 0.0f;
+	}
 
+	void comp_character_controller::update(world& w, float dt, JPH::TempAllocator& allocator)
+	{
 		physics_world& pw = w.get_physics_world();
 		const vector3& g  = pw.get_gravity();
 
@@ -143,9 +143,11 @@ namespace SFG
 		settings.mWalkStairsStepForwardTest					   = _step_forward_test;
 		settings.mWalkStairsCosAngleForwardContact			   = math::cos(math::degrees_to_radians(_step_forward_contact_angle_degrees));
 
-		JPH::TempAllocatorImpl* allocator = pw.get_allocator();
-		if (allocator)
-			_controller->ExtendedUpdate(dt, to_jph_vec3(g), settings, bp_filter, obj_filter, body_filter, shape_filter, *allocator);
+		_controller->ExtendedUpdate(dt, to_jph_vec3(g), settings, bp_filter, obj_filter, body_filter, shape_filter, allocator);
+	}
+
+	void comp_character_controller::write_back(world& w)
+	{
 		entity_manager& em	 = w.get_entity_manager();
 		const JPH::Vec3 jpos = JPH::Vec3(_controller->GetPosition());
 		em.set_entity_position_abs(_header.entity, from_jph_vec3(jpos));
@@ -34,6 +34,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace JPH
 {
 	class CharacterVirtual;
+	class TempAllocator;
 }
 
 namespace SFG
@@ -48,7 +49,9 @@ namespace SFG
 		void on_add(world& w);
 		void on_remove(world& w);
 
-		void update(world& w, float dt);
+		bool prepare_update(world& w, float dt);
+		void update(world& w, float dt, JPH::TempAllocator& allocator);
+		void write_back(world& w);
 		void rebuild(world& w);
 		void set_position(world& w, const vector3& pos);
 
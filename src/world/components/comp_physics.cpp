@@ -137,6 +137,8 @@ namespace SFG
 			bd = physics_body_type::static_body;
 
 		_body = phy_world.create_body(bd, shape_type, extent, _material_handle, _is_sensor, pos, rot, scale, mesh_shape);
+		_body->SetUserData(to_jph_user_data(_header.entity));
+		phy_world.bind_body_comp(*_body, _header.own_handle);
 		return _body;
 	}
 
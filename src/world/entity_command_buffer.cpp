@@ -0,0 +1,207 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "entity_command_buffer.hpp"
+#include "world/world.hpp"
+#include "io/assert.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+
+namespace SFG
+{
+	void entity_command_buffer::playback(world& w, entity_command_buffer* buffers, uint32 count)
+	{
+		ZoneScoped;
+
+		entity_manager&	   em = w.get_entity_manager();
+		component_manager& cm = w.get_comp_manager();
+
+		// creations first, so every later command in any buffer sees real handles.
+		for (uint32 i = 0; i < count; i++)
+		{
+			entity_command_buffer& buffer = buffers[i];
+			buffer._resolved.resize(buffer._creates.size());
+
+			for (size_t j = 0; j < buffer._creates.size(); j++)
+			{
+				const create_command& create = buffer._creates[j];
+				const world_handle	  handle = em.create_entity(buffer._text.data() + create.name_offset);
+				buffer._resolved[j]			 = handle;
+				if (create.out != nullptr)
+					*create.out = handle;
+			}
+		}
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			entity_command_buffer& buffer = buffers[i];
+
+			for (const entity_command& cmd : buffer._commands)
+			{
+				if (cmd.command == entity_command_type::destroy)
+					continue;
+
+				const world_handle entity = buffer.resolve(cmd.entity);
+				if (!em.is_valid(entity))
+					continue;
+
+				switch (cmd.command)
+				{
+					case entity_command_type::add_component: {
+						const world_handle comp = cm.add_component(cmd.type, entity);
+						if (cmd.out != nullptr)
+							*cmd.out = comp;
+						break;
+					}
+					case entity_command_type::add_child: {
+						const world_handle child = buffer.resolve(cmd.other);
+						if (em.is_valid(child))
+							em.add_child(entity, child);
+						break;
+					}
+					case entity_command_type::set_position:
+						em.set_entity_position(entity, vector3(cmd.value.x, cmd.value.y, cmd.value.z));
+						break;
+					case entity_command_type::set_rotation:
+						em.set_entity_rotation(entity, cmd.value);
+						break;
+					case entity_command_type::set_scale:
+						em.set_entity_scale(entity, vector3(cmd.value.x, cmd.value.y, cmd.value.z));
+						break;
+					case entity_command_type::set_tag:
+						em.set_entity_tag(entity, buffer._text.data() + cmd.text_offset);
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		// destructions last, commands above may still target entities destroyed in the same frame.
+		static vector<world_handle> reuse_destroys;
+		reuse_destroys.resize(0);
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			entity_command_buffer& buffer = buffers[i];
+
+			for (const entity_command& cmd : buffer._commands)
+			{
+				if (cmd.command != entity_command_type::destroy)
+					continue;
+
+				const world_handle entity = buffer.resolve(cmd.entity);
+				if (em.is_valid(entity))
+					reuse_destroys.push_back(entity);
+			}
+		}
+
+		// valid handles with the same index are the same entity, sort-unique instead of a search per destroy.
+		std::sort(reuse_destroys.begin(), reuse_destroys.end(), [](world_handle a, world_handle b) -> bool { return a.index < b.index; });
+		reuse_destroys.erase(std::unique(reuse_destroys.begin(), reuse_destroys.end(), [](world_handle a, world_handle b) -> bool { return a.index == b.index; }), reuse_destroys.end());
+
+		if (!reuse_destroys.empty())
+			em.destroy_entities(reuse_destroys.data(), static_cast<uint32>(reuse_destroys.size()));
+	}
+
+	deferred_entity entity_command_buffer::create_entity(const char* name, world_handle* out)
+	{
+		deferred_entity entity = {};
+		entity.provisional	   = static_cast<uint32>(_creates.size());
+
+		_creates.push_back({
+			.out		 = out,
+			.name_offset = push_text(name),
+		});
+
+		return entity;
+	}
+
+	void entity_command_buffer::destroy_entity(const deferred_entity& entity)
+	{
+		push_command({.entity = entity, .command = entity_command_type::destroy});
+	}
+
+	void entity_command_buffer::add_component(string_id type, const deferred_entity& entity, world_handle* out)
+	{
+		push_command({.entity = entity, .out = out, .type = type, .command = entity_command_type::add_component});
+	}
+
+	void entity_command_buffer::add_child(const deferred_entity& parent, const deferred_entity& child)
+	{
+		push_command({.entity = parent, .other = child, .command = entity_command_type::add_child});
+	}
+
+	void entity_command_buffer::set_position(const deferred_entity& entity, const vector3& pos)
+	{
+		push_command({.value = quat(pos.x, pos.y, pos.z, 0.0f), .entity = entity, .command = entity_command_type::set_position});
+	}
+
+	void entity_command_buffer::set_rotation(const deferred_entity& entity, const quat& rot)
+	{
+		push_command({.value = rot, .entity = entity, .command = entity_command_type::set_rotation});
+	}
+
+	void entity_command_buffer::set_scale(const deferred_entity& entity, const vector3& scale)
+	{
+		push_command({.value = quat(scale.x, scale.y, scale.z, 0.0f), .entity = entity, .command = entity_command_type::set_scale});
+	}
+
+	void entity_command_buffer::set_tag(const deferred_entity& entity, const char* tag)
+	{
+		push_command({.entity = entity, .text_offset = push_text(tag), .command = entity_command_type::set_tag});
+	}
+
+	void entity_command_buffer::clear()
+	{
+		_creates.resize(0);
+		_commands.resize(0);
+		_resolved.resize(0);
+		_text.resize(0);
+	}
+
+	uint32 entity_command_buffer::push_text(const char* text)
+	{
+		const uint32 offset = static_cast<uint32>(_text.size());
+		const size_t len	= strlen(text);
+		_text.insert(_text.end(), text, text + len + 1);
+		return offset;
+	}
+
+	world_handle entity_command_buffer::resolve(const deferred_entity& entity) const
+	{
+		if (entity.provisional == NULL_PROVISIONAL_ENTITY)
+			return entity.handle;
+
+		SFG_ASSERT(entity.provisional < _resolved.size());
+		return _resolved[entity.provisional];
+	}
+
+	void entity_command_buffer::push_command(const entity_command& cmd)
+	{
+		_commands.push_back(cmd);
+	}
+}
@@ -0,0 +1,123 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "data/vector.hpp"
+#include "world/world_constants.hpp"
+#include "math/vector3.hpp"
+#include "math/quat.hpp"
+#include "common/type_id.hpp"
+
+namespace SFG
+{
+	class world;
+
+#define NULL_PROVISIONAL_ENTITY 0xFFFFFFFF
+
+	// either a live entity or one created earlier in the same command buffer.
+	struct deferred_entity
+	{
+		deferred_entity() = default;
+		deferred_entity(world_handle h) : handle(h) {};
+
+		world_handle handle		 = {};
+		uint32		 provisional = NULL_PROVISIONAL_ENTITY;
+	};
+
+	enum class entity_command_type : uint8
+	{
+		add_component,
+		add_child,
+		set_position,
+		set_rotation,
+		set_scale,
+		set_tag,
+		destroy,
+	};
+
+	/*
+	 * Records structural entity changes from a single thread, give every job its own buffer (see world::record_parallel).
+	 * Nothing touches the world until playback, which runs on the main thread at a sync point:
+	 * all creations first, then the remaining commands in record order, destructions last.
+	 * Buffers are played back in array order so the result doesn't depend on thread timing.
+	 */
+	class entity_command_buffer
+	{
+	public:
+		static void playback(world& w, entity_command_buffer* buffers, uint32 count);
+
+		// out, when given, receives the real handle during playback.
+		deferred_entity create_entity(const char* name, world_handle* out = nullptr);
+		void			destroy_entity(const deferred_entity& entity);
+		void			add_component(string_id type, const deferred_entity& entity, world_handle* out = nullptr);
+		void			add_child(const deferred_entity& parent, const deferred_entity& child);
+		void			set_position(const deferred_entity& entity, const vector3& pos);
+		void			set_rotation(const deferred_entity& entity, const quat& rot);
+		void			set_scale(const deferred_entity& entity, const vector3& scale);
+		void			set_tag(const deferred_entity& entity, const char* tag);
+		void			clear();
+
+		template <typename T> inline void add_component(const deferred_entity& entity, world_handle* out = nullptr)
+		{
+			add_component(type_id<T>::value, entity, out);
+		}
+
+		inline bool is_empty() const
+		{
+			return _creates.empty() && _commands.empty();
+		}
+
+	private:
+		struct create_command
+		{
+			world_handle* out		  = nullptr;
+			uint32		  name_offset = 0;
+		};
+
+		struct entity_command
+		{
+			quat				value		= quat::identity;
+			deferred_entity		entity		= {};
+			deferred_entity		other		= {};
+			world_handle*		out			= nullptr;
+			string_id			type		= 0;
+			uint32				text_offset = 0;
+			entity_command_type command		= entity_command_type::add_component;
+		};
+
+		uint32		 push_text(const char* text);
+		world_handle resolve(const deferred_entity& entity) const;
+		void		 push_command(const entity_command& cmd);
+
+	private:
+		vector<create_command> _creates	 = {};
+		vector<entity_command> _commands = {};
+		vector<world_handle>   _resolved = {};
+		vector<char>		   _text	 = {};
+	};
+}
@@ -60,6 +60,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Body/Body.h>
 #include <tracy/Tracy.hpp>
+#include <algorithm>
 
 namespace SFG
 {
@@ -304,6 +305,17 @@ namespace SFG
 		}
 	}
 
+	void entity_manager::set_entity_render_transform(world_handle entity, const vector3& pos, const quat& rot)
+	{
+		SFG_ASSERT(_entities->is_valid(entity));
+		if (!_flags->get(entity.index).is_set(entity_flags::entity_flags_is_render_proxy))
+			return;
+
+		entity_transform& render_locals = _render_local_transforms->get(entity.index);
+		render_locals.position			= pos;
+		render_locals.rotation			= rot;
+	}
+
 #endif
 
 	void entity_manager::uninit()
@@ -338,6 +350,7 @@ namespace SFG
 
 	void entity_manager::reset_all_entity_data()
 	{
+		_shared_texts.clear();
 		_entities->reset();
 		_template_references->reset();
 		_aabbs->reset();
@@ -356,12 +369,28 @@ namespace SFG
 #endif
 	}
 
+	void entity_manager::release_text(const char* text)
+	{
+		if (text == nullptr)
+			return;
+
+		auto it = _shared_texts.find(text);
+		if (it != _shared_texts.end())
+		{
+			if (--it->second != 0)
+				return;
+			_shared_texts.erase(it);
+		}
+
+		_world.get_text_allocator().deallocate(text);
+	}
+
 	void entity_manager::reset_entity_data(world_handle handle)
 	{
 		const world_id id	= handle.index;
 		entity_meta&   meta = _metas->get(id);
-		_world.get_text_allocator().deallocate(meta.name);
-		_world.get_text_allocator().deallocate(meta.tag);
+		release_text(meta.name);
+		release_text(meta.tag);
 
 		entity_comp_register& reg		   = _comp_registers->get(id);
 		auto				  copied_comps = reg.comps;
@@ -620,6 +649,123 @@ namespace SFG
 	}
 
 	void entity_manager::destroy_entity(world_handle entity)
+	{
+		destroy_entities(&entity, 1);
+	}
+
+	void entity_manager::create_entities(uint32 count, world_handle* out, const char* name, const char* tag)
+	{
+		_entities->add(out, count);
+
+		const matrix4x3 def = matrix4x3::transform(vector3::zero, quat::identity, vector3::one);
+		text_allocator& ta	= _world.get_text_allocator();
+
+		// one allocation per batch, shared by every entity in it and released with the last one.
+		const char* shared_name = ta.allocate(name);
+		const char* shared_tag	= ta.allocate(tag);
+		if (count > 1)
+		{
+			if (shared_name != nullptr)
+				_shared_texts[shared_name] = count;
+			if (shared_tag != nullptr)
+				_shared_texts[shared_tag] = count;
+		}
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			const world_id id = out[i].index;
+
+			_local_transforms->get(id).scale = vector3::one;
+			_abs_matrices->get(id)			 = def;
+
+			entity_meta& meta = _metas->get(id);
+			meta.name		  = shared_name;
+			meta.tag		  = shared_tag;
+		}
+
+#ifdef SFG_TOOLMODE
+		_hierarchy_dirty = 1;
+#endif
+	}
+
+	void entity_manager::destroy_entities(const world_handle* entities, uint32 count)
+	{
+		ZoneScoped;
+		SFG_ASSERT(_batch_destroying == 0);
+
+		// detach all roots before collecting, so a root living under another root is only gathered once.
+		_batch_entities.resize(0);
+		for (uint32 i = 0; i < count; i++)
+			unlink_entity_family(entities[i]);
+		for (uint32 i = 0; i < count; i++)
+			collect_subtree(entities[i], _batch_entities);
+
+		// pull every simulated body out of the physics system at once, components only destroy their bodies afterwards.
+		component_manager&		   cm = _world.get_comp_manager();
+		static vector<JPH::BodyID> reuse_body_ids;
+		reuse_body_ids.resize(0);
+
+		for (world_handle e : _batch_entities)
+		{
+			for (const entity_comp& c : _comp_registers->get(e.index).comps)
+			{
+				if (c.comp_type != type_id<comp_physics>::value)
+					continue;
+
+				comp_physics& phy = cm.get_component<comp_physics>(c.comp_handle);
+				if (phy.get_body() == nullptr || !phy.get_flags().is_set(comp_physics::flags::comp_physics_flags_in_sim))
+					continue;
+
+				reuse_body_ids.push_back(phy.get_body()->GetID());
+				phy.set_is_in_simulation(false);
+			}
+		}
+
+		if (!reuse_body_ids.empty())
+			_world.get_physics_world().remove_bodies_from_world(reuse_body_ids.data(), static_cast<uint32>(reuse_body_ids.size()));
+
+		// render proxies released while tearing down components are sent as a single event.
+		_batch_destroying = 1;
+		_batch_proxy_removals.resize(0);
+
+		// collected parents come before their children, walk backwards to tear down children first.
+		for (auto it = _batch_entities.rbegin(); it != _batch_entities.rend(); ++it)
+		{
+			const world_handle e = *it;
+			remove_all_entity_components(e);
+			reset_entity_data(e);
+			_entities->remove(e);
+		}
+
+		_batch_destroying = 0;
+
+		if (!_batch_proxy_removals.empty())
+		{
+			auto&		  proxies = *_proxy_entities;
+			world_handle* last	  = std::remove_if(proxies.begin(), proxies.end(), [this](world_handle h) -> bool { return !_entities->is_valid(h) || !_flags->get(h.index).is_set(entity_flags::entity_flags_is_render_proxy); });
+			proxies.resize(static_cast<size_t>(last - proxies.begin()));
+
+			const render_event_entity_batch ev = {
+				.indices = _batch_proxy_removals.data(),
+				.count	 = static_cast<uint32>(_batch_proxy_removals.size()),
+			};
+			_world.get_render_stream().add_event({.index = 0, .event_type = render_event_type::remove_entities}, ev);
+		}
+
+#ifdef SFG_TOOLMODE
+		_hierarchy_dirty = 1;
+#endif
+	}
+
+	void entity_manager::destroy_entities_by_tag(const char* tag)
+	{
+		static vector<world_handle> reuse_tagged;
+		find_entities_by_tag(tag, reuse_tagged);
+		if (!reuse_tagged.empty())
+			destroy_entities(reuse_tagged.data(), static_cast<uint32>(reuse_tagged.size()));
+	}
+
+	void entity_manager::unlink_entity_family(world_handle entity)
 	{
 		SFG_ASSERT(_entities->is_valid(entity));
 
@@ -659,22 +805,27 @@ namespace SFG
 			fam_next.prev_sibling	= fam.prev_sibling;
 		}
 
-		// Destroy children recursively.
-		world_handle target_child = fam.first_child;
-		while (!target_child.is_null())
-		{
-			world_handle next = get_entity_family(target_child).next_sibling;
-			destroy_entity(target_child);
-			target_child = next;
-		}
+		fam.parent		 = {};
+		fam.prev_sibling = {};
+		fam.next_sibling = {};
+	}
 
-		remove_all_entity_components(entity);
-		reset_entity_data(entity);
-		_entities->remove(entity);
+	void entity_manager::collect_subtree(world_handle root, vector<world_handle>& out)
+	{
+		size_t cursor = out.size();
+		out.push_back(root);
 
-#ifdef SFG_TOOLMODE
-		_hierarchy_dirty = 1;
-#endif
+		while (cursor < out.size())
+		{
+			world_handle child = _families->get(out[cursor].index).first_child;
+			cursor++;
+
+			while (!child.is_null())
+			{
+				out.push_back(child);
+				child = _families->get(child.index).next_sibling;
+			}
+		}
 	}
 
 	const aabb& entity_manager::get_entity_aabb(world_handle entity)
@@ -687,7 +838,7 @@ namespace SFG
 	{
 		SFG_ASSERT(_entities->is_valid(entity));
 		entity_meta& meta = _metas->get(entity.index);
-		_world.get_text_allocator().deallocate(meta.name);
+		release_text(meta.name);
 		meta.name = _world.get_text_allocator().allocate(name);
 	}
 
@@ -695,7 +846,7 @@ namespace SFG
 	{
 		SFG_ASSERT(_entities->is_valid(entity));
 		entity_meta& meta = _metas->get(entity.index);
-		_world.get_text_allocator().deallocate(meta.tag);
+		release_text(meta.tag);
 		meta.tag = _world.get_text_allocator().allocate(tag ? tag : "");
 	}
 
@@ -911,8 +1062,16 @@ namespace SFG
 		meta.render_proxy_count--;
 		if (meta.render_proxy_count == 0)
 		{
-			_proxy_entities->remove(entity);
 			_flags->get(entity.index).remove(entity_flags::entity_flags_is_render_proxy);
+
+			// batch destroys compact the proxy list and send one event once all components are gone.
+			if (_batch_destroying)
+			{
+				_batch_proxy_removals.push_back(entity.index);
+				return;
+			}
+
+			_proxy_entities->remove(entity);
 			_world.get_render_stream().add_event({.index = entity.index, .event_type = render_event_type::remove_entity});
 		}
 	}
@@ -945,43 +1104,6 @@ namespace SFG
 
 		reg.comps.resize(0);
 	}
-	/*
-	world_handle entity_manager::spawn_template(resource_handle templ, const vector3& pos, const quat& rot, const vector3& scale)
-	{
-		resource_manager& rm = _world.get_resource_manager();
-		SFG_ASSERT(rm.is_valid<entity_template>(templ));
-		entity_template&		   t   = rm.get_resource<entity_template>(templ);
-		const entity_template_raw& raw = t.get_raw();
-
-		static_vector<world_handle, 1024> created = {};
-
-		component_manager& cm = _world.get_comp_manager();
-
-		uint32 i = 0;
-		for (const entity_template_entity_raw& r : raw.entities)
-		{
-			const world_handle h = create_entity(r.name.c_str());
-
-			// add components
-
-			for (const entity_template_component_raw& c : r.components)
-			{
-			}
-			// transformation
-			set_entity_position(h, r.position);
-			set_entity_rotation(h, r.rotation);
-			set_entity_scale(h, r.scale);
-
-			// set vis
-			set_entity_visible(h, r.visible);
-
-			created[i] = h;
-			i++;
-		}
-
-		return {};
-	}
-	*/
 	world_handle entity_manager::get_valid_handle_by_index(world_id id)
 	{
 		const world_id gen = _entities->get_generation(id);
@@ -1192,7 +1314,7 @@ namespace SFG
 		return root;
 	}
 
-	world_handle entity_manager::instantiate_template(const entity_template_raw& raw)
+	world_handle entity_manager::instantiate_template(const entity_template_raw& raw, vector<world_handle>* out_roots)
 	{
 		resource_manager&  rm = _world.get_resource_manager();
 		component_manager& cm = _world.get_comp_manager();
@@ -1234,6 +1356,8 @@ namespace SFG
 			{
 				add_child(created[r.parent], created[i]);
 			}
+			else if (out_roots)
+				out_roots->push_back(created[i]);
 		}
 
 		istream stream(raw.component_buffer.get_raw(), raw.component_buffer.get_size());
@@ -1271,16 +1395,198 @@ namespace SFG
 
 	world_handle entity_manager::instantiate_template(resource_handle template_handle)
 	{
+		world_handle root = {};
+		spawn_template(template_handle, 1, nullptr, &root);
+		return root;
+	}
+
+	void entity_manager::spawn_template(resource_handle templ, uint32 count, const entity_transform* transforms, world_handle* out_roots)
+	{
+		ZoneScoped;
 		resource_manager&  rm = _world.get_resource_manager();
 		component_manager& cm = _world.get_comp_manager();
 
-		const entity_template&	   et	= rm.get_resource<entity_template>(template_handle);
-		const entity_template_raw& raw	= et.get_raw();
-		const world_handle		   root = instantiate_template(raw);
+		entity_template&	  et   = rm.get_resource<entity_template>(templ);
+		entity_template_plan& plan = et.get_plan();
+		if (!plan.is_compiled())
+			plan.compile(et.get_raw());
 
-		if (!root.is_null())
-			set_entity_template(root, template_handle);
-		return root;
+		const uint32 entity_count = static_cast<uint32>(plan.get_entities().size());
+
+		if (!plan.is_supported() || entity_count == 0)
+		{
+			const entity_template_raw& raw = et.get_raw();
+			for (uint32 c = 0; c < count; c++)
+			{
+				const world_handle root = instantiate_template(raw);
+				if (!root.is_null())
+				{
+					set_entity_template(root, templ);
+					if (transforms)
+						_local_transforms->get(root.index) = transforms[c];
+				}
+				if (out_roots)
+					out_roots[c] = root;
+			}
+			return;
+		}
+
+		// copy c of template entity i lives at i * count + c.
+		static vector<world_handle> reuse_created;
+		reuse_created.resize(entity_count * count);
+
+		const auto&	 plan_entities = plan.get_entities();
+		const uint8* data		   = plan.get_data();
+
+		for (uint32 i = 0; i < entity_count; i++)
+		{
+			const entity_template_plan_entity& e	   = plan_entities[i];
+			world_handle*					   created = reuse_created.data() + i * count;
+			create_entities(count, created, reinterpret_cast<const char*>(data + e.name_offset), reinterpret_cast<const char*>(data + e.tag_offset));
+
+			const entity_transform local = {
+				.position = e.position,
+				.scale	  = e.scale,
+				.rotation = e.rotation,
+			};
+
+			for (uint32 c = 0; c < count; c++)
+			{
+				const world_handle h			= created[c];
+				_local_transforms->get(h.index) = (i == 0 && transforms) ? transforms[c] : local;
+				teleport_entity(h);
+				set_entity_visible(h, e.visible);
+			}
+		}
+
+		for (uint32 i = 0; i < entity_count; i++)
+		{
+			const int32 parent = plan_entities[i].parent;
+			if (parent == -1)
+				continue;
+
+			for (uint32 c = 0; c < count; c++)
+				add_child(reuse_created[parent * count + c], reuse_created[i * count + c]);
+		}
+
+		const auto&	 plan_fields = plan.get_fields();
+		const uint32 field_count = static_cast<uint32>(plan_fields.size());
+		const bool	 add_bodies	 = _world.get_playmode() != play_mode::none;
+
+		// plans keep resource hashes, resolved once here so every copy shares the lookups.
+		static vector<resource_handle> reuse_resources;
+		static vector<uint32>		   reuse_resource_starts;
+		reuse_resources.resize(0);
+		reuse_resource_starts.resize(field_count);
+
+		for (uint32 f = 0; f < field_count; f++)
+		{
+			const entity_template_plan_field& pf = plan_fields[f];
+			if (pf.op != entity_template_plan_op::resource && pf.op != entity_template_plan_op::resource_list)
+				continue;
+
+			reuse_resource_starts[f] = static_cast<uint32>(reuse_resources.size());
+
+			const uint32 total = pf.data_size / static_cast<uint32>(sizeof(string_id));
+			for (uint32 k = 0; k < total; k++)
+			{
+				string_id hash = 0;
+				SFG_MEMCPY(&hash, data + pf.data_offset + k * sizeof(string_id), sizeof(string_id));
+				reuse_resources.push_back(hash == 0 ? resource_handle() : rm.get_resource_handle_by_hash_if_exists(pf.sub_type, hash));
+			}
+		}
+
+		static vector<comp_physics*> reuse_physics;
+		reuse_physics.resize(0);
+
+		// component-major, so every copy of a component hits the same pool back to back.
+		for (const entity_template_plan_comp& pc : plan.get_comps())
+		{
+			const world_handle* owners = reuse_created.data() + pc.entity_index * count;
+
+			for (uint32 c = 0; c < count; c++)
+			{
+				const world_handle comp_handle = cm.add_component(pc.comp_type, owners[c]);
+				if (comp_handle.is_null())
+					continue;
+
+				void* comp_ptr = cm.get_component(pc.comp_type, comp_handle);
+
+				for (uint32 f = pc.field_start; f < pc.field_start + pc.field_count; f++)
+				{
+					const entity_template_plan_field& pf  = plan_fields[f];
+					field_value						  val = pf.target->value(comp_ptr);
+					const uint8*					  src = data + pf.data_offset;
+
+					switch (pf.op)
+					{
+					case entity_template_plan_op::pod:
+						SFG_MEMCPY(val.cast_ptr<uint8>(), src, pf.data_size);
+						break;
+					case entity_template_plan_op::string:
+						val.cast_ref<string>() = reinterpret_cast<const char*>(src);
+						break;
+					case entity_template_plan_op::resource:
+						val.cast_ref<resource_handle>() = reuse_resources[reuse_resource_starts[f]];
+						break;
+					case entity_template_plan_op::resource_list: {
+						const resource_handle* handles = reuse_resources.data() + reuse_resource_starts[f];
+						auto&				   v	   = val.cast_ref<vector<resource_handle>>();
+						v.insert(v.end(), handles, handles + pf.data_size / sizeof(string_id));
+						break;
+					}
+					case entity_template_plan_op::entity: {
+						int32 idx = -1;
+						SFG_MEMCPY(&idx, src, sizeof(int32));
+						val.cast_ref<world_handle>() = idx == -1 ? world_handle() : reuse_created[idx * count + c];
+						break;
+					}
+					case entity_template_plan_op::entity_list: {
+						auto&		 v	   = val.cast_ref<vector<world_handle>>();
+						const uint32 total = pf.data_size / static_cast<uint32>(sizeof(int32));
+						for (uint32 k = 0; k < total; k++)
+						{
+							int32 idx = -1;
+							SFG_MEMCPY(&idx, src + k * sizeof(int32), sizeof(int32));
+							v.push_back(idx == -1 ? world_handle() : reuse_created[idx * count + c]);
+						}
+						break;
+					}
+					default:
+						break;
+					}
+				}
+
+				if (pc.has_load_cb)
+					pc.comp_meta->invoke_function<void, void*, world&>("on_reflect_load"_hs, comp_ptr, _world);
+
+				if (add_bodies && pc.is_physics)
+					reuse_physics.push_back(static_cast<comp_physics*>(comp_ptr));
+			}
+		}
+
+		// bodies are created once every component is in place, then added in one go.
+		if (!reuse_physics.empty())
+		{
+			static vector<JPH::BodyID> reuse_body_ids;
+			reuse_body_ids.resize(0);
+
+			for (comp_physics* phy : reuse_physics)
+			{
+				phy->set_is_in_simulation(true);
+				reuse_body_ids.push_back(phy->create_body(_world)->GetID());
+			}
+
+			_world.get_physics_world().add_bodies_to_world(reuse_body_ids.data(), static_cast<uint32>(reuse_body_ids.size()));
+		}
+
+		for (uint32 c = 0; c < count; c++)
+		{
+			const world_handle root = reuse_created[c];
+			set_entity_template(root, templ);
+			if (out_roots)
+				out_roots[c] = root;
+		}
 	}
 
 #ifdef SFG_TOOLMODE
@@ -28,6 +28,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "common_world.hpp"
 #include "common_entity.hpp"
 #include "data/vector.hpp"
+#include "data/hash_map.hpp"
 #include "memory/static_array.hpp"
 #include "memory/pool_allocator_gen.hpp"
 #include "memory/chunk_allocator.hpp"
@@ -73,6 +74,7 @@ namespace SFG
 #if FIXED_FRAMERATE_ENABLED && FIXED_FRAMERATE_USE_INTERPOLATION
 		void interpolate_entities(double interpolation);
 		void set_previous_transforms();
+		void set_entity_render_transform(world_handle entity, const vector3& pos, const quat& rot);
 #endif
 
 		// -----------------------------------------------------------------------------
@@ -84,6 +86,9 @@ namespace SFG
 		world_handle				find_entity(world_handle parent, const char* name);
 		const char*					get_entity_tag(world_handle h);
 		void						destroy_entity(world_handle handle);
+		void						create_entities(uint32 count, world_handle* out, const char* name = "entity", const char* tag = "");
+		void						destroy_entities(const world_handle* entities, uint32 count);
+		void						destroy_entities_by_tag(const char* tag);
 		world_handle				clone_entity(world_handle source, world_handle target_parent = {});
 		void						add_child(world_handle parent, world_handle child);
 		void						remove_child(world_handle parent, world_handle child);
@@ -113,7 +118,7 @@ namespace SFG
 		// -----------------------------------------------------------------------------
 
 		world_handle instantiate_model(resource_handle model_handle);
-		world_handle instantiate_template(const entity_template_raw& er);
+		world_handle instantiate_template(const entity_template_raw& er, vector<world_handle>* out_roots = nullptr);
 		world_handle instantiate_template(resource_handle template_handle);
 
 #ifdef SFG_TOOLMODE
@@ -124,7 +129,7 @@ namespace SFG
 		// templates
 		// -----------------------------------------------------------------------------
 
-		// world_handle spawn_template(resource_handle templ, const vector3& pos, const quat& rot, const vector3& scale);
+		void spawn_template(resource_handle templ, uint32 count, const entity_transform* transforms = nullptr, world_handle* out_roots = nullptr);
 
 		inline bool is_valid(world_handle entity) const
 		{
@@ -261,7 +266,10 @@ namespace SFG
 		void on_component_removed(world_handle entity, world_handle comp_handle, string_id comp_type);
 		void reset_all_entity_data();
 		void reset_entity_data(world_handle handle);
+		void release_text(const char* text);
 		void update_entity_flags_to_render(world_handle handle);
+		void unlink_entity_family(world_handle entity);
+		void collect_subtree(world_handle root, vector<world_handle>& out);
 
 	private:
 		struct instantiated_model
@@ -294,6 +302,13 @@ namespace SFG
 		world_handle _camera_entity = {};
 		world_handle _camera_comp	= {};
 
+		vector<world_handle> _batch_entities	   = {};
+		vector<world_id>	 _batch_proxy_removals = {};
+		uint8				 _batch_destroying	   = 0;
+
+		// texts shared by a create_entities batch, remaining references.
+		hash_map<const char*, uint32> _shared_texts = {};
+
 #ifdef SFG_TOOLMODE
 		uint8 _hierarchy_dirty = 0;
 #endif
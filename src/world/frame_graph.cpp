@@ -0,0 +1,111 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "frame_graph.hpp"
+#include "io/assert.hpp"
+
+#include <algorithm>
+#include <execution>
+#include <tracy/Tracy.hpp>
+
+namespace SFG
+{
+	void frame_graph::add_task(const char* name, void (*fn)(void*), void* ctx, uint32 reads, uint32 writes)
+	{
+		SFG_ASSERT(_tasks.size() < MAX_TASKS);
+		_tasks.push_back({
+			.fn		= fn,
+			.ctx	= ctx,
+			.name	= name,
+			.reads	= reads,
+			.writes = writes,
+		});
+	}
+
+	void frame_graph::compile()
+	{
+		const uint32 count = static_cast<uint32>(_tasks.size());
+		_wave_count		   = 0;
+
+		for (uint32 i = 0; i < count; i++)
+		{
+			frame_task& task = _tasks[i];
+			task.wave		 = 0;
+
+			for (uint32 j = 0; j < i; j++)
+			{
+				const frame_task& prev		= _tasks[j];
+				const bool		  conflicts = (prev.writes & (task.reads | task.writes)) != 0 || (prev.reads & task.writes) != 0;
+				if (conflicts)
+					task.wave = std::max(task.wave, static_cast<uint8>(prev.wave + 1));
+			}
+
+			_wave_count = std::max(_wave_count, static_cast<uint8>(task.wave + 1));
+		}
+
+		_ordered.clear();
+		_wave_starts.clear();
+
+		for (uint8 wave = 0; wave < _wave_count; wave++)
+		{
+			_wave_starts.push_back(static_cast<uint8>(_ordered.size()));
+			for (const frame_task& task : _tasks)
+			{
+				if (task.wave == wave)
+					_ordered.push_back(task);
+			}
+		}
+
+		_wave_starts.push_back(static_cast<uint8>(_ordered.size()));
+	}
+
+	void frame_graph::execute()
+	{
+		ZoneScoped;
+
+		for (uint8 wave = 0; wave < _wave_count; wave++)
+		{
+			frame_task* begin = _ordered.begin() + _wave_starts[wave];
+			frame_task* end	  = _ordered.begin() + _wave_starts[wave + 1];
+
+			if (end - begin == 1)
+			{
+				(*begin)();
+				continue;
+			}
+
+			std::for_each(std::execution::par, begin, end, [](const frame_task& task) { task(); });
+		}
+	}
+
+	void frame_graph::clear()
+	{
+		_tasks.clear();
+		_ordered.clear();
+		_wave_starts.clear();
+		_wave_count = 0;
+	}
+}
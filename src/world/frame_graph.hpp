@@ -0,0 +1,92 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "data/static_vector.hpp"
+
+namespace SFG
+{
+	// shared state a frame task touches, tasks conflict when one writes what the other reads or writes.
+	enum frame_access : uint32
+	{
+		frame_access_time		   = 1 << 0,
+		frame_access_transforms	   = 1 << 1,
+		frame_access_animation	   = 1 << 2,
+		frame_access_physics	   = 1 << 3,
+		frame_access_characters	   = 1 << 4,
+		frame_access_canvases	   = 1 << 5,
+		frame_access_audio		   = 1 << 6,
+		frame_access_resources	   = 1 << 7,
+		frame_access_render_stream = 1 << 8,
+		frame_access_camera		   = 1 << 9,
+		frame_access_all		   = 0xFFFFFFFF,
+	};
+
+	struct frame_task
+	{
+		void (*fn)(void*)  = nullptr;
+		void*		ctx	   = nullptr;
+		const char* name   = "";
+		uint32		reads  = 0;
+		uint32		writes = 0;
+		uint8		wave   = 0;
+
+		void operator()() const
+		{
+			fn(ctx);
+		}
+	};
+
+	/*
+	 * Declarative task list for a frame. Tasks are added in their logical order with read/write sets,
+	 * compile places each task in the earliest wave after every earlier task it conflicts with,
+	 * execute runs waves in order and the tasks inside a wave in parallel.
+	 */
+	class frame_graph
+	{
+	public:
+		static constexpr uint32 MAX_TASKS = 16;
+
+		void add_task(const char* name, void (*fn)(void*), void* ctx, uint32 reads, uint32 writes);
+		void compile();
+		void execute();
+		void clear();
+
+		inline uint8 get_wave_count() const
+		{
+			return _wave_count;
+		}
+
+	private:
+		static_vector<frame_task, MAX_TASKS> _tasks		  = {};
+		static_vector<frame_task, MAX_TASKS> _ordered	  = {};
+		static_vector<uint8, MAX_TASKS + 1>	 _wave_starts = {};
+		uint8								 _wave_count  = 0;
+	};
+}
@@ -25,6 +25,9 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "time_manager.hpp"
+#include "game/app_defines.hpp"
+#include "math/math.hpp"
+#include <algorithm>
 
 namespace SFG
 {
@@ -32,6 +35,12 @@ namespace SFG
 	{
 		_elapsed_game_time = 0.0f;
 		_elapsed_real_time = 0.0f;
+
+		// phases keep the slower subsystems from landing on the same tick.
+		set_subsystem_rate(time_subsystem::physics, PHYSICS_RATE_HZ, 0.0f);
+		set_subsystem_rate(time_subsystem::animation, ANIMATION_RATE_HZ, 0.5f);
+		set_subsystem_rate(time_subsystem::ai, AI_RATE_HZ, 0.25f);
+		set_subsystem_rate(time_subsystem::audio_listener, AUDIO_LISTENER_RATE_HZ, 0.75f);
 	}
 
 	void time_manager::uninit()
@@ -40,4 +49,36 @@ namespace SFG
 		_elapsed_real_time = 0.0f;
 	}
 
-}
\ No newline at end of file
+	void time_manager::tick(float dt)
+	{
+		_elapsed_real_time += dt;
+		_elapsed_game_time += dt * _time_speed;
+		_real_dt = dt;
+
+		// cadence follows real time so slow motion keeps stepping smoothly with shorter steps instead of fewer.
+		for (time_subsystem_schedule& s : _subsystems)
+		{
+			if (s.period <= 0.0f)
+			{
+				s.steps = 1;
+				continue;
+			}
+
+			s.accumulator += dt;
+
+			// small bias absorbs float drift when the tick rate is a multiple of the subsystem rate.
+			const uint32 due = static_cast<uint32>(s.accumulator / s.period + 0.001f);
+			s.steps			 = static_cast<uint8>(std::min(due, static_cast<uint32>(MAX_SUBSYSTEM_STEPS)));
+			s.accumulator	 = due > MAX_SUBSYSTEM_STEPS ? 0.0f : math::max(s.accumulator - static_cast<float>(due) * s.period, 0.0f);
+		}
+	}
+
+	void time_manager::set_subsystem_rate(time_subsystem subsystem, float hz, float phase)
+	{
+		time_subsystem_schedule& s = _subsystems[static_cast<uint8>(subsystem)];
+		s.period				   = hz > 0.0f ? 1.0f / hz : 0.0f;
+		s.accumulator			   = s.period * phase;
+		s.steps					   = 0;
+	}
+
+}
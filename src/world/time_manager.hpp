@@ -24,28 +24,72 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+
 #pragma once
 #include "common/size_definitions.hpp"
 
 namespace SFG
 {
+	enum class time_subsystem : uint8
+	{
+		physics = 0,
+		animation,
+		ai,
+		audio_listener,
+		count,
+	};
+
+	struct time_subsystem_schedule
+	{
+		float period	  = 0.0f;
+		float accumulator = 0.0f;
+		uint8 steps		  = 0;
+	};
+
 	class time_manager
 	{
 	public:
+		static constexpr uint8 MAX_SUBSYSTEM_STEPS = 4;
+
 		// -----------------------------------------------------------------------------
 		// lifecycle
 		// -----------------------------------------------------------------------------
 
 		void init();
 		void uninit();
+		void tick(float dt);
 
-		inline float tick(float dt)
+		// -----------------------------------------------------------------------------
+		// subsystem scheduling
+		// -----------------------------------------------------------------------------
+
+		// phase is a fraction of the period, subsystems with the same rate but different phases step on different ticks.
+		// a rate of 0 steps the subsystem once every tick with the tick's dt.
+		void set_subsystem_rate(time_subsystem subsystem, float hz, float phase = 0.0f);
+
+		// fixed steps due for this tick, 0 means the subsystem should be skipped.
+		inline uint8 get_subsystem_steps(time_subsystem subsystem) const
+		{
+			return _subsystems[static_cast<uint8>(subsystem)].steps;
+		}
+
+		// game time advanced by a single step, scaled by time speed.
+		inline float get_subsystem_dt(time_subsystem subsystem) const
 		{
-			const float modified = dt * _time_speed;
-			_elapsed_real_time += dt;
-			_elapsed_game_time += modified;
-			_real_dt = dt;
-			return modified;
+			const time_subsystem_schedule& s = _subsystems[static_cast<uint8>(subsystem)];
+			return (s.period > 0.0f ? s.period : _real_dt) * _time_speed;
+		}
+
+		// how far real time is into the next step, for interpolating between the last two subsystem states.
+		// time_since_tick is real time elapsed past the last tick, e.g. the frame's interpolation fraction of a tick.
+		inline float get_subsystem_alpha(time_subsystem subsystem, float time_since_tick = 0.0f) const
+		{
+			const time_subsystem_schedule& s = _subsystems[static_cast<uint8>(subsystem)];
+			if (s.period <= 0.0f)
+				return 1.0f;
+
+			const float alpha = (s.accumulator + time_since_tick) / s.period;
+			return alpha < 1.0f ? alpha : 1.0f;
 		}
 
 		// -----------------------------------------------------------------------------
@@ -86,9 +130,10 @@ namespace SFG
 		}
 
 	private:
-		float _elapsed_real_time = 0.0f;
-		float _elapsed_game_time = 0.0f;
-		float _time_speed		 = 1.0f;
-		float _real_dt			 = 0.0f;
+		time_subsystem_schedule _subsystems[static_cast<uint8>(time_subsystem::count)] = {};
+		float					_elapsed_real_time									   = 0.0f;
+		float					_elapsed_game_time									   = 0.0f;
+		float					_time_speed											   = 1.0f;
+		float					_real_dt											   = 0.0f;
 	};
 }
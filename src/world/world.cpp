@@ -29,6 +29,7 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "platform/window.hpp"
 #include "app/package_manager.hpp"
 #include "gui/vekt.hpp"
+#include "math/math.hpp"
 
 // resources
 #include "resources/texture.hpp"
@@ -83,11 +84,14 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "components/comp_character_controller.hpp"
 
 #include <vendor/miniaudio/miniaudio.h>
+#include <algorithm>
+#include <execution>
+#include <numeric>
 #include <tracy/Tracy.hpp>
 
 namespace SFG
 {
-	world::world(render_event_stream& rstream) : _entity_manager(*this), _comp_manager(*this), _render_stream(rstream), _resource_manager(*this), _phy_world(*this)
+	world::world(render_event_stream& rstream) : _entity_manager(*this), _comp_manager(*this), _render_stream(rstream), _resource_manager(*this), _resource_streamer(_resource_manager), _cell_streamer(*this), _phy_world(*this)
 	{
 		_vekt_atlases.reserve(32);
 		_text_allocator.init(MAX_ENTITIES * 32);
@@ -140,6 +144,16 @@ namespace SFG
 		_vekt_fonts->set_atlas_destroyed_callback(on_atlas_destroyed);
 
 		_debug_rendering.init();
+
+		// tasks are declared in logical tick order, the access sets decide what may overlap.
+		// abs transform getters refresh cached matrices, so tasks reading world positions declare transform writes.
+		_frame_graph.add_task("resources", task_resources, this, 0, frame_access_all);
+		_frame_graph.add_task("animation", task_animation, this, frame_access_time, frame_access_animation | frame_access_transforms);
+		_frame_graph.add_task("physics", task_physics, this, frame_access_time, frame_access_physics | frame_access_characters | frame_access_transforms);
+		_frame_graph.add_task("canvases", task_canvases, this, 0, frame_access_canvases | frame_access_render_stream);
+		_frame_graph.add_task("audio", task_audio, this, frame_access_time, frame_access_audio | frame_access_transforms);
+		_frame_graph.add_task("camera", task_camera, this, 0, frame_access_camera | frame_access_transforms);
+		_frame_graph.compile();
 	};
 
 	world::~world()
@@ -175,6 +189,8 @@ namespace SFG
 
 	void world::uninit_preserve_resources()
 	{
+		_cell_streamer.uninit();
+		_resource_streamer.uninit();
 		_comp_manager.uninit();
 		_entity_manager.uninit();
 		_time_manager.uninit();
@@ -198,6 +214,7 @@ namespace SFG
 		const entity_template_raw& tr = raw.entities_raw;
 
 		_loaded_extra_resources = raw.extra_resources;
+		_cell_size				= raw.cell_size;
 
 #ifdef SFG_TOOLMODE
 		_tool_camera_pos = raw.tool_cam_pos;
@@ -207,46 +224,98 @@ namespace SFG
 #else
 		package& pkg = package_manager::get().open_package_res();
 		_resource_manager.load_resources(tr.resources, pkg);
-		pkg.close();
+
+		// level resources are resident, the package stays mapped for runtime requests.
+		_resource_streamer.init(pkg);
 #endif
 
 		_entity_manager.instantiate_template(tr);
+
+#ifndef SFG_TOOLMODE
+		// spatial cells of a partitioned level stream in around the camera from here on.
+		_cell_streamer.init(raw);
+#endif
 	}
 
 	void world::tick(const vector2ui16& res, float dt)
 	{
 		ZoneScoped;
 
-		// modify dt
-		dt = _time_manager.tick(dt);
+		_time_manager.tick(dt);
 
-		const float time_speed = _time_manager.get_time_speed();
+		_frame_graph.execute();
 
-		_anim_graph.tick(*this, dt);
-		_resource_manager.tick();
+		// listeners run gameplay code with no declared access set, they only run once every task is done.
+		_phy_world.flush_contacts();
+	}
 
-		if (_play_mode != play_mode::none)
-			_phy_world.simulate(dt);
+	void world::task_resources(void* ctx)
+	{
+		ZoneScoped;
+		world* w = static_cast<world*>(ctx);
+		w->_resource_manager.tick();
+		w->_resource_streamer.tick();
+		w->_cell_streamer.tick();
+	}
+
+	void world::task_animation(void* ctx)
+	{
+		ZoneScoped;
+		world*		  w			 = static_cast<world*>(ctx);
+		time_manager& tm		 = w->_time_manager;
+		const uint8	  anim_steps = tm.get_subsystem_steps(time_subsystem::animation);
+		if (anim_steps != 0)
+			w->_anim_graph.tick(*w, tm.get_subsystem_dt(time_subsystem::animation) * anim_steps);
+	}
+
+	void world::task_physics(void* ctx)
+	{
+		ZoneScoped;
+		world* w = static_cast<world*>(ctx);
+		if (w->_play_mode == play_mode::none)
+			return;
 
-		auto& canvases = _comp_manager.underlying_pool<comp_cache<comp_canvas, MAX_WORLD_COMP_CANVAS>, comp_canvas>();
+		time_manager& tm			= w->_time_manager;
+		const uint8	  physics_steps = tm.get_subsystem_steps(time_subsystem::physics);
+		const float	  physics_dt	= tm.get_subsystem_dt(time_subsystem::physics);
+		for (uint8 i = 0; i < physics_steps; i++)
+			w->_phy_world.simulate(physics_dt);
+	}
+
+	void world::task_canvases(void* ctx)
+	{
+		ZoneScoped;
+		world* w		= static_cast<world*>(ctx);
+		auto&  canvases = w->_comp_manager.underlying_pool<comp_cache<comp_canvas, MAX_WORLD_COMP_CANVAS>, comp_canvas>();
 		for (comp_canvas& c : canvases)
-			c.draw(*this, _screen.get_world_resolution());
+			c.draw(*w, w->_screen.get_world_resolution());
+	}
 
-		auto& audios = _comp_manager.underlying_pool<comp_cache<comp_audio, MAX_WORLD_COMP_AUDIO>, comp_audio>();
+	void world::task_audio(void* ctx)
+	{
+		ZoneScoped;
+		world*			w	   = static_cast<world*>(ctx);
+		entity_manager& em	   = w->_entity_manager;
+		auto&			audios = w->_comp_manager.underlying_pool<comp_cache<comp_audio, MAX_WORLD_COMP_AUDIO>, comp_audio>();
 		for (comp_audio& c : audios)
 		{
 			if (c.get_attenuation() != sound_attenuation::none)
-				c.set_audio_position(*this, _entity_manager.get_entity_position_abs(c.get_header().entity));
+				c.set_audio_position(*w, em.get_entity_position_abs(c.get_header().entity));
 		}
 
-		const world_handle mc = _entity_manager.get_main_camera_entity();
-		if (!mc.is_null())
+		const world_handle mc = em.get_main_camera_entity();
+		if (!mc.is_null() && w->_time_manager.get_subsystem_steps(time_subsystem::audio_listener) != 0)
 		{
-			const vector3 p = _entity_manager.get_entity_position_abs(mc);
-			ma_engine_listener_set_position(_audio_manager.get_engine(), 0, p.x, p.y, p.z);
+			const vector3 p = em.get_entity_position_abs(mc);
+			ma_engine_listener_set_position(w->_audio_manager.get_engine(), 0, p.x, p.y, p.z);
 		}
+	}
 
-		_screen.fetch_camera_data(*this);
+	void world::task_camera(void* ctx)
+	{
+		ZoneScoped;
+		world* w = static_cast<world*>(ctx);
+		w->_screen.fetch_camera_data(*w);
 	}
 
 	void world::begin_debug_tick(const vector2ui16& res)
@@ -264,11 +333,45 @@ namespace SFG
 		_entity_manager.calculate_abs_transforms();
 	}
 
+	void world::flush_entity_commands()
+	{
+		entity_command_buffer::playback(*this, _command_buffers, MAX_ENTITY_COMMAND_BUFFERS);
+		for (entity_command_buffer& buffer : _command_buffers)
+			buffer.clear();
+	}
+
+	void world::record_parallel(uint32 count, void* ctx, void (*fn)(void* ctx, uint32 index, entity_command_buffer& buffer))
+	{
+		ZoneScoped;
+
+		if (count == 0)
+			return;
+
+		const uint32 per_job = (count + MAX_ENTITY_COMMAND_BUFFERS - 1) / MAX_ENTITY_COMMAND_BUFFERS;
+		uint32		 jobs[MAX_ENTITY_COMMAND_BUFFERS];
+		std::iota(jobs, jobs + MAX_ENTITY_COMMAND_BUFFERS, 0u);
+
+		std::for_each(std::execution::par, jobs, jobs + MAX_ENTITY_COMMAND_BUFFERS, [&](uint32 job) {
+			entity_command_buffer& buffer = _command_buffers[job];
+			const uint32		   begin  = job * per_job;
+			const uint32		   end	  = math::min(begin + per_job, count);
+			for (uint32 i = begin; i < end; i++)
+				fn(ctx, i, buffer);
+		});
+	}
+
 #if FIXED_FRAMERATE_ENABLED && FIXED_FRAMERATE_USE_INTERPOLATION
 
 	void world::interpolate(double interpolation)
 	{
 		_entity_manager.interpolate_entities(interpolation);
+
+		// physics may step slower than the tick, its entities blend between the last two steps instead of the last two ticks.
+		if (_play_mode != play_mode::none)
+		{
+			const float time_since_tick = static_cast<float>(interpolation) * _time_manager.get_real_dt();
+			_phy_world.interpolate_bodies(_time_manager.get_subsystem_alpha(time_subsystem::physics, time_since_tick));
+		}
 	}
 
 	void world::set_prev_transforms()
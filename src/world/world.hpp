@@ -35,10 +35,14 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "world/component_manager.hpp"
 #include "world/common_world.hpp"
 #include "world/time_manager.hpp"
+#include "world/frame_graph.hpp"
+#include "world/entity_command_buffer.hpp"
 #include "world/world_debug_rendering.hpp"
 #include "world/world_screen.hpp"
+#include "world/world_cell_streamer.hpp"
 
 #include "resources/resource_manager.hpp"
+#include "resources/resource_streamer.hpp"
 #include "physics/physics_world.hpp"
 #include "audio/audio_manager.hpp"
 
@@ -87,6 +91,14 @@ namespace SFG
 		void begin_debug_tick(const vector2ui16& res);
 		void end_debug_tick();
 		void calculate_abs_transforms();
+		void flush_entity_commands();
+
+		/*
+		 * Runs fn for every index in [0, count) in parallel, split into MAX_ENTITY_COMMAND_BUFFERS contiguous jobs.
+		 * Each job records into the command buffer of its job index, so recording needs no locks and
+		 * playback order depends only on the index range, never on which thread ran a job.
+		 */
+		void record_parallel(uint32 count, void* ctx, void (*fn)(void* ctx, uint32 index, entity_command_buffer& buffer));
 
 #if FIXED_FRAMERATE_ENABLED && FIXED_FRAMERATE_USE_INTERPOLATION
 		void interpolate(double interpolation);
@@ -164,6 +176,16 @@ namespace SFG
 			return _resource_manager;
 		}
 
+		inline resource_streamer& get_resource_streamer()
+		{
+			return _resource_streamer;
+		}
+
+		inline world_cell_streamer& get_cell_streamer()
+		{
+			return _cell_streamer;
+		}
+
 		inline audio_manager& get_audio_manager()
 		{
 			return _audio_manager;
@@ -179,11 +201,29 @@ namespace SFG
 			return _time_manager;
 		}
 
+		// one buffer per job index, played back in flush_entity_commands. serial code records into job 0,
+		// parallel code gets its buffer from record_parallel since pool threads have no stable index.
+		inline entity_command_buffer& get_command_buffer(uint32 job)
+		{
+			SFG_ASSERT(job < MAX_ENTITY_COMMAND_BUFFERS);
+			return _command_buffers[job];
+		}
+
 		inline const vector<string>& get_extra_resources() const
 		{
 			return _loaded_extra_resources;
 		}
 
+		inline float get_cell_size() const
+		{
+			return _cell_size;
+		}
+
+		inline void set_cell_size(float size)
+		{
+			_cell_size = size;
+		}
+
 #ifdef SFG_TOOLMODE
 
 		inline void set_tool_camera_pos(const vector3& p)
@@ -221,10 +261,23 @@ namespace SFG
 		static void on_atlas_updated(vekt::atlas* atlas, void* user_data);
 		static void on_atlas_destroyed(vekt::atlas* atlas, void* user_data);
 
+		// -----------------------------------------------------------------------------
+		// frame tasks
+		// -----------------------------------------------------------------------------
+
+		static void task_resources(void* ctx);
+		static void task_animation(void* ctx);
+		static void task_physics(void* ctx);
+		static void task_canvases(void* ctx);
+		static void task_audio(void* ctx);
+		static void task_camera(void* ctx);
+
 	private:
 		vekt::font_manager* _vekt_fonts = nullptr;
 
 		resource_manager	  _resource_manager;
+		resource_streamer	  _resource_streamer;
+		world_cell_streamer	  _cell_streamer;
 		entity_manager		  _entity_manager;
 		physics_world		  _phy_world;
 		component_manager	  _comp_manager;
@@ -234,13 +287,17 @@ namespace SFG
 		time_manager		  _time_manager	   = {};
 		world_debug_rendering _debug_rendering = {};
 		world_screen		  _screen		   = {};
+		frame_graph			  _frame_graph	   = {};
 
 		vector<atlas_data>	 _vekt_atlases			 = {};
 		vector<string>		 _loaded_extra_resources = {};
 		render_event_stream& _render_stream;
 
+		entity_command_buffer _command_buffers[MAX_ENTITY_COMMAND_BUFFERS];
+
 		bitmask<uint8> _flags	  = 0;
 		play_mode	   _play_mode = play_mode::none;
+		float		   _cell_size = 0.0f;
 
 #ifdef SFG_TOOLMODE
 		vector3 _tool_camera_pos = vector3::zero;
@@ -0,0 +1,357 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "world_cell_streamer.hpp"
+#include "world/world.hpp"
+#include "world/entity_manager.hpp"
+#include "resources/world_raw.hpp"
+#include "resources/entity_template.hpp"
+#include "resources/entity_template_raw.hpp"
+#include "platform/time.hpp"
+#include "math/math.hpp"
+#include "math/vector3.hpp"
+#include "io/log.hpp"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+namespace SFG
+{
+	world_cell_streamer::world_cell_streamer(world& w) : _world(w)
+	{
+	}
+
+	void world_cell_streamer::init(const world_raw& raw)
+	{
+		uninit();
+
+		if (raw.cells.empty() || raw.cell_size <= 0.0f)
+			return;
+
+		_cell_size	   = raw.cell_size;
+		_load_radius   = raw.cell_size * WORLD_CELL_LOAD_RADIUS;
+		_unload_radius = raw.cell_size * WORLD_CELL_UNLOAD_RADIUS;
+
+		_cells.reserve(raw.cells.size());
+		for (const world_cell_raw& c : raw.cells)
+		{
+			_cells.push_back({
+				.template_path = c.template_path,
+				.template_sid  = TO_SID(c.template_path),
+				.resources	   = c.resources,
+				.x			   = c.x,
+				.z			   = c.z,
+			});
+		}
+
+		// the persistent part of the level is resident for the world's lifetime, cells never unload what it uses.
+		pin(raw.entities_raw.resources);
+		pin(raw.extra_resources);
+	}
+
+	void world_cell_streamer::uninit()
+	{
+		resource_streamer& rs = _world.get_resource_streamer();
+		for (const cell& c : _cells)
+		{
+			if (c.state == cell_state::loading)
+				rs.cancel(c.request);
+		}
+
+		_cells.clear();
+		_focus.clear();
+		_resource_refs.clear();
+	}
+
+	void world_cell_streamer::tick()
+	{
+		if (_cells.empty())
+			return;
+
+		ZoneScoped;
+
+		entity_manager&	   em = _world.get_entity_manager();
+		resource_streamer& rs = _world.get_resource_streamer();
+
+		static vector<vector3> reuse_points;
+		static vector<uint32>  reuse_ready;
+		static vector<uint32>  reuse_unload;
+		reuse_points.resize(0);
+		reuse_ready.resize(0);
+		reuse_unload.resize(0);
+
+		const world_handle cam = em.get_main_camera_entity();
+		if (!cam.is_null() && em.is_valid(cam))
+			reuse_points.push_back(em.get_entity_position_abs(cam));
+
+		_focus.erase(std::remove_if(_focus.begin(), _focus.end(), [&em](world_handle h) -> bool { return !em.is_valid(h); }), _focus.end());
+		for (world_handle h : _focus)
+			reuse_points.push_back(em.get_entity_position_abs(h));
+
+		if (reuse_points.empty())
+			return;
+
+		for (uint32 i = 0; i < static_cast<uint32>(_cells.size()); i++)
+		{
+			cell& c	   = _cells[i];
+			c.distance = MATH_INF_F;
+			for (const vector3& p : reuse_points)
+				c.distance = math::min(c.distance, distance_to(c, p));
+
+			// loading and unloading use different radii so a focus moving along a border doesn't thrash.
+			const bool in_range	 = c.distance <= _load_radius;
+			const bool out_range = c.distance > _unload_radius;
+
+			switch (c.state)
+			{
+			case cell_state::unloaded: {
+				if (!in_range)
+					break;
+
+				// references are taken before anything loads, so a neighbour unloading meanwhile can't pull shared resources.
+				acquire_resources(c);
+
+				const resource_request_priority priority = c.distance == 0.0f ? resource_request_priority::high : resource_request_priority::normal;
+				c.request								 = rs.request({c.template_path}, priority, on_cell_loaded, this);
+				c.state									 = cell_state::loading;
+
+				if (c.request == NULL_RESOURCE_REQUEST)
+				{
+					release_resources(c);
+					c.state = cell_state::failed;
+				}
+				break;
+			}
+			case cell_state::loading: {
+				if (!out_range)
+					break;
+
+				rs.cancel(c.request);
+				release_resources(c);
+				c.request = NULL_RESOURCE_REQUEST;
+				c.state	  = cell_state::unloaded;
+				break;
+			}
+			case cell_state::ready: {
+				if (!out_range)
+				{
+					reuse_ready.push_back(i);
+					break;
+				}
+
+				release_resources(c);
+				c.state = cell_state::unloaded;
+				break;
+			}
+			case cell_state::loaded: {
+				if (out_range)
+					reuse_unload.push_back(i);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		// unloads go first so memory is back before new cells land, nearest cells instantiate first.
+		// every tick performs at least one operation so small budgets still converge.
+		std::sort(reuse_ready.begin(), reuse_ready.end(), [this](uint32 a, uint32 b) -> bool { return _cells[a].distance < _cells[b].distance; });
+
+		const int64 begin_us  = time::get_cpu_microseconds();
+		const int64 budget_us = static_cast<int64>(_budget_ms * 1000.0f);
+
+		for (uint32 i : reuse_unload)
+		{
+			unload_cell(_cells[i]);
+			if (time::get_cpu_microseconds() - begin_us >= budget_us)
+				return;
+		}
+
+		for (uint32 i : reuse_ready)
+		{
+			instantiate_cell(_cells[i]);
+			if (time::get_cpu_microseconds() - begin_us >= budget_us)
+				return;
+		}
+	}
+
+	void world_cell_streamer::add_focus(world_handle entity)
+	{
+		if (std::find(_focus.begin(), _focus.end(), entity) == _focus.end())
+			_focus.push_back(entity);
+	}
+
+	void world_cell_streamer::remove_focus(world_handle entity)
+	{
+		_focus.erase(std::remove(_focus.begin(), _focus.end(), entity), _focus.end());
+	}
+
+	void world_cell_streamer::on_cell_loaded(resource_request_id id, resource_request_status status, void* user_data)
+	{
+		world_cell_streamer* self = static_cast<world_cell_streamer*>(user_data);
+
+		auto it = std::find_if(self->_cells.begin(), self->_cells.end(), [id](const cell& c) -> bool { return c.request == id; });
+		if (it == self->_cells.end())
+			return;
+
+		cell& c	  = *it;
+		c.request = NULL_RESOURCE_REQUEST;
+
+		if (status == resource_request_status::failed)
+			SFG_WARN("world cell loaded with missing resources: {0}", c.template_path.c_str());
+
+		resource_manager& rm = self->_world.get_resource_manager();
+		if (rm.get_resource_handle_by_hash_if_exists<entity_template>(c.template_sid).is_null())
+		{
+			SFG_ERR("failed loading world cell: {0}", c.template_path.c_str());
+			self->release_resources(c);
+			c.state = cell_state::failed;
+			return;
+		}
+
+		c.state = cell_state::ready;
+	}
+
+	float world_cell_streamer::distance_to(const cell& c, const vector3& p) const
+	{
+		const float min_x = static_cast<float>(c.x) * _cell_size;
+		const float min_z = static_cast<float>(c.z) * _cell_size;
+		const float dx	  = math::max(math::max(min_x - p.x, 0.0f), p.x - (min_x + _cell_size));
+		const float dz	  = math::max(math::max(min_z - p.z, 0.0f), p.z - (min_z + _cell_size));
+		return math::sqrt(dx * dx + dz * dz);
+	}
+
+	void world_cell_streamer::instantiate_cell(cell& c)
+	{
+		ZoneScoped;
+
+		resource_manager&	   rm = _world.get_resource_manager();
+		const resource_handle  h  = rm.get_resource_handle_by_hash<entity_template>(c.template_sid);
+		const entity_template& et = rm.get_resource<entity_template>(h);
+
+		c.roots.resize(0);
+		_world.get_entity_manager().instantiate_template(et.get_raw(), &c.roots);
+		c.state = cell_state::loaded;
+	}
+
+	void world_cell_streamer::unload_cell(cell& c)
+	{
+		ZoneScoped;
+
+		// gameplay may have destroyed some of the cell's entities already.
+		entity_manager& em = _world.get_entity_manager();
+		c.roots.erase(std::remove_if(c.roots.begin(), c.roots.end(), [&em](world_handle h) -> bool { return !em.is_valid(h); }), c.roots.end());
+		if (!c.roots.empty())
+			em.destroy_entities(c.roots.data(), static_cast<uint32>(c.roots.size()));
+
+		c.roots.resize(0);
+		release_resources(c);
+		c.state = cell_state::unloaded;
+	}
+
+	void world_cell_streamer::acquire_resources(const cell& c)
+	{
+		resource_manager& rm = _world.get_resource_manager();
+
+		auto add_ref = [&](const string& p) {
+			const string_id type = rm.resolve_type(p);
+			if (type == 0)
+				return;
+
+			const string_id sid = TO_SID(p);
+			auto			it	= _resource_refs.find(sid);
+			if (it == _resource_refs.end() || it->second.count == 0)
+			{
+				// first reference decides ownership, something resident already was loaded elsewhere and stays.
+				resource_ref& ref = _resource_refs[sid];
+				ref.type		  = type;
+				ref.owned		  = rm.get_resource_handle_by_hash_if_exists(type, sid).is_null();
+				ref.count		  = 1;
+				return;
+			}
+
+			it->second.count++;
+		};
+
+		// cooked cell manifests list the full sub-resource closure, so shared textures and meshes are counted too.
+		add_ref(c.template_path);
+		for (const string& p : c.resources)
+			add_ref(p);
+	}
+
+	void world_cell_streamer::release_resources(const cell& c)
+	{
+		resource_manager& rm = _world.get_resource_manager();
+
+		static vector<string_id> reuse_unused;
+		reuse_unused.resize(0);
+
+		auto drop_ref = [&](const string& p) {
+			const string_id sid = TO_SID(p);
+			auto			it	= _resource_refs.find(sid);
+			if (it == _resource_refs.end() || it->second.count == 0)
+				return;
+
+			resource_ref& ref = it->second;
+			ref.count--;
+			if (ref.count != 0 || ref.pinned != 0)
+				return;
+
+			if (ref.owned != 0)
+				reuse_unused.push_back(sid);
+			else
+				_resource_refs.erase(it);
+		};
+
+		drop_ref(c.template_path);
+		for (const string& p : c.resources)
+			drop_ref(p);
+
+		// higher load priorities were created later and depend on lower ones, so they go first.
+		std::sort(reuse_unused.begin(), reuse_unused.end(), [&](string_id a, string_id b) -> bool {
+			return rm.get_load_priority(_resource_refs.at(a).type) > rm.get_load_priority(_resource_refs.at(b).type);
+		});
+
+		for (string_id sid : reuse_unused)
+		{
+			auto it = _resource_refs.find(sid);
+			if (it == _resource_refs.end())
+				continue;
+
+			rm.unload_resource(it->second.type, sid);
+			_resource_refs.erase(it);
+		}
+	}
+
+	void world_cell_streamer::pin(const vector<string>& relative_paths)
+	{
+		for (const string& p : relative_paths)
+		{
+			if (!p.empty())
+				_resource_refs[TO_SID(p)].pinned = 1;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+/*
+This file is a part of stakeforge_engine: https://github.com/inanevin/stakeforge
+Copyright [2025-] Inan Evin
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice, this
+	  list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright notice,
+	  this list of conditions and the following disclaimer in the documentation
+	  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "common/size_definitions.hpp"
+#include "common/string_id.hpp"
+#include "data/vector.hpp"
+#include "data/string.hpp"
+#include "data/hash_map.hpp"
+#include "world/world_constants.hpp"
+#include "resources/resource_streamer.hpp"
+
+namespace SFG
+{
+	class world;
+	struct world_raw;
+	struct entity_template_raw;
+	struct vector3;
+
+#define WORLD_CELL_BUDGET_MS	 2.0f
+#define WORLD_CELL_LOAD_RADIUS	 1.0f
+#define WORLD_CELL_UNLOAD_RADIUS 1.5f
+
+	/*
+	 * Keeps cooked world cells resident around the main camera and any registered focus entities.
+	 * Cells within the load radius are streamed in and instantiated under a time budget, cells past the larger unload radius
+	 * are destroyed together with the resources no other loaded cell or the persistent level still references.
+	 * A cell references its cooked manifest from the moment it is requested until it is unloaded or cancelled, and only
+	 * resources that were not resident when first referenced are ever unloaded, loads made elsewhere are left alone.
+	 */
+	class world_cell_streamer
+	{
+	private:
+		enum class cell_state : uint8
+		{
+			unloaded,
+			loading,
+			ready,
+			loaded,
+			failed,
+		};
+
+		struct cell
+		{
+			string				 template_path = "";
+			string_id			 template_sid  = 0;
+			vector<string>		 resources	   = {};
+			vector<world_handle> roots		   = {};
+			resource_request_id	 request	   = NULL_RESOURCE_REQUEST;
+			int32				 x			   = 0;
+			int32				 z			   = 0;
+			float				 distance	   = 0.0f;
+			cell_state			 state		   = cell_state::unloaded;
+		};
+
+		struct resource_ref
+		{
+			string_id type	 = 0;
+			uint32	  count	 = 0;
+			uint8	  pinned = 0;
+			uint8	  owned	 = 0;
+		};
+
+	public:
+		world_cell_streamer() = delete;
+		world_cell_streamer(world& w);
+
+		void init(const world_raw& raw);
+		void uninit();
+		void tick();
+		void add_focus(world_handle entity);
+		void remove_focus(world_handle entity);
+
+		inline void set_radius(float load_radius, float unload_radius)
+		{
+			_load_radius   = load_radius;
+			_unload_radius = unload_radius < load_radius ? load_radius : unload_radius;
+		}
+
+		inline void set_budget(float milliseconds)
+		{
+			_budget_ms = milliseconds;
+		}
+
+		inline bool is_active() const
+		{
+			return !_cells.empty();
+		}
+
+	private:
+		static void on_cell_loaded(resource_request_id id, resource_request_status status, void* user_data);
+
+		float distance_to(const cell& c, const vector3& p) const;
+		void  instantiate_cell(cell& c);
+		void  unload_cell(cell& c);
+		void  acquire_resources(const cell& c);
+		void  release_resources(const cell& c);
+		void  pin(const vector<string>& relative_paths);
+
+	private:
+		world&							  _world;
+		vector<cell>					  _cells;
+		vector<world_handle>			  _focus;
+		hash_map<string_id, resource_ref> _resource_refs;
+		float							  _cell_size	 = 0.0f;
+		float							  _load_radius	 = 0.0f;
+		float							  _unload_radius = 0.0f;
+		float							  _budget_ms	 = WORLD_CELL_BUDGET_MS;
+	};
+}